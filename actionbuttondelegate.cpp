@@ -0,0 +1,192 @@
+#include "actionbuttondelegate.h"
+#include <QAbstractItemView>
+#include <QPainter>
+#include <QMouseEvent>
+#include <QHelpEvent>
+#include <QToolTip>
+
+namespace {
+const int kMargin = 4;
+const int kSpacing = 6;
+const int kHorizontalPadding = 10;
+const int kVerticalPadding = 4;
+}
+
+ActionButtonDelegate::ActionButtonDelegate(const QVector<ActionButton>& buttons, QAbstractItemView* view)
+    : QStyledItemDelegate(view)
+    , m_buttons(buttons)
+    , m_view(view)
+    , m_cornerRadius(8)
+    , m_hoverButton(-1)
+    , m_pressedButton(-1)
+{
+    // Üzerine gelme efekti için fare hareketleri tıklama olmadan da gelmeli
+    m_view->viewport()->setMouseTracking(true);
+    m_view->viewport()->installEventFilter(this);
+}
+
+void ActionButtonDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    // Seçim ve alternatif satır arka planı
+    QStyledItemDelegate::paint(painter, option, index);
+
+    QVector<QRect> rects = buttonRects(option, index);
+    if (rects.isEmpty()) return;
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setFont(buttonFont(option.font));
+    for (int i = 0; i < rects.count(); ++i) {
+        const ActionButton& button = m_buttons.at(i);
+        bool hovered = m_hoverIndex == index && m_hoverButton == i;
+
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(hovered && button.hoverColor.isValid() ? button.hoverColor : button.color);
+        painter->drawRoundedRect(rects.at(i), m_cornerRadius, m_cornerRadius);
+
+        painter->setPen(Qt::white);
+        painter->drawText(rects.at(i), Qt::AlignCenter, button.text);
+    }
+    painter->restore();
+}
+
+QSize ActionButtonDelegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    QFontMetrics fm(buttonFont(option.font));
+    int width = 2 * kMargin + qMax(0, m_buttons.count() - 1) * kSpacing;
+    for (const ActionButton& button : m_buttons) {
+        width += fm.horizontalAdvance(button.text) + 2 * kHorizontalPadding;
+    }
+    int height = fm.height() + 2 * (kVerticalPadding + kMargin);
+    return QSize(width, qMax(height, QStyledItemDelegate::sizeHint(option, index).height()));
+}
+
+bool ActionButtonDelegate::editorEvent(QEvent* event, QAbstractItemModel* model,
+                                       const QStyleOptionViewItem& option, const QModelIndex& index)
+{
+    switch (event->type()) {
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonDblClick: {
+        QMouseEvent* mouseEvent = static_cast<QMouseEvent*>(event);
+        int button = buttonAt(option, index, mouseEvent->position().toPoint());
+        if (mouseEvent->button() == Qt::LeftButton && button >= 0) {
+            m_pressedIndex = index;
+            m_pressedButton = button;
+            return true;
+        }
+        break;
+    }
+    case QEvent::MouseButtonRelease: {
+        QMouseEvent* mouseEvent = static_cast<QMouseEvent*>(event);
+        int button = buttonAt(option, index, mouseEvent->position().toPoint());
+        bool clicked = mouseEvent->button() == Qt::LeftButton && button >= 0
+            && m_pressedIndex == index && m_pressedButton == button;
+        m_pressedIndex = QPersistentModelIndex();
+        m_pressedButton = -1;
+        if (clicked) {
+            // Bağlı slot modeli sıfırlayabilir; görünüm bu olayı işlerken indeks geçersiz kalmasın.
+            // Satır numarası yerine kalıcı indeks taşınır: sinyal işlenene kadar model değişirse
+            // yanlış kayıt üzerinde işlem yapılmaz.
+            QPersistentModelIndex clickedIndex(index);
+            QMetaObject::invokeMethod(this, [this, clickedIndex, button]() {
+                emit buttonClicked(clickedIndex, button);
+            }, Qt::QueuedConnection);
+            return true;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    return QStyledItemDelegate::editorEvent(event, model, option, index);
+}
+
+bool ActionButtonDelegate::helpEvent(QHelpEvent* event, QAbstractItemView* view,
+                                     const QStyleOptionViewItem& option, const QModelIndex& index)
+{
+    int button = buttonAt(option, index, event->pos());
+    if (button >= 0 && !m_buttons.at(button).toolTip.isEmpty()) {
+        QToolTip::showText(event->globalPos(), m_buttons.at(button).toolTip, view);
+        return true;
+    }
+    return QStyledItemDelegate::helpEvent(event, view, option, index);
+}
+
+bool ActionButtonDelegate::eventFilter(QObject* watched, QEvent* event)
+{
+    if (watched != m_view->viewport()) {
+        return QStyledItemDelegate::eventFilter(watched, event);
+    }
+
+    // Fare hareketi viewport'tan izlenir: buton sütunundan başka hücreye ya da tablonun
+    // dışına çıkıldığında da üzerine gelme efekti kalkar
+    if (event->type() == QEvent::MouseMove) {
+        QPoint pos = static_cast<QMouseEvent*>(event)->position().toPoint();
+        QModelIndex index = m_view->indexAt(pos);
+        int button = -1;
+        if (index.isValid() && m_view->itemDelegateForIndex(index) == this) {
+            QStyleOptionViewItem option;
+            option.rect = m_view->visualRect(index);
+            option.font = m_view->font();
+            button = buttonAt(option, index, pos);
+        }
+        setHover(index, button);
+    } else if (event->type() == QEvent::Leave) {
+        setHover(QModelIndex(), -1);
+    }
+    return QStyledItemDelegate::eventFilter(watched, event);
+}
+
+QVector<QRect> ActionButtonDelegate::buttonRects(const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    QVector<QRect> rects;
+    if (m_visible && !m_visible(index)) return rects;
+
+    QFontMetrics fm(buttonFont(option.font));
+    QRect area = option.rect.adjusted(kMargin, kMargin, -kMargin, -kMargin);
+    int height = qMin(area.height(), fm.height() + 2 * kVerticalPadding);
+    int top = area.top() + (area.height() - height) / 2;
+    int left = area.left();
+
+    rects.reserve(m_buttons.count());
+    for (const ActionButton& button : m_buttons) {
+        int width = fm.horizontalAdvance(button.text) + 2 * kHorizontalPadding;
+        rects.append(QRect(left, top, width, height));
+        left += width + kSpacing;
+    }
+    return rects;
+}
+
+int ActionButtonDelegate::buttonAt(const QStyleOptionViewItem& option, const QModelIndex& index, const QPoint& pos) const
+{
+    QVector<QRect> rects = buttonRects(option, index);
+    for (int i = 0; i < rects.count(); ++i) {
+        if (rects.at(i).contains(pos)) return i;
+    }
+    return -1;
+}
+
+QFont ActionButtonDelegate::buttonFont(const QFont& base) const
+{
+    QFont font = base;
+    font.setBold(true);
+    return font;
+}
+
+void ActionButtonDelegate::setHover(const QModelIndex& index, int button)
+{
+    QModelIndex hoverIndex = button >= 0 ? index : QModelIndex();
+    if (m_hoverIndex == hoverIndex && m_hoverButton == button) return;
+
+    // Sadece eski ve yeni hücre yeniden çizilir
+    if (m_hoverIndex.isValid()) m_view->update(m_hoverIndex);
+    m_hoverIndex = hoverIndex;
+    m_hoverButton = button;
+    if (m_hoverIndex.isValid()) m_view->update(m_hoverIndex);
+
+    if (button >= 0) {
+        m_view->viewport()->setCursor(Qt::PointingHandCursor);
+    } else {
+        m_view->viewport()->unsetCursor();
+    }
+}
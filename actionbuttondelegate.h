@@ -0,0 +1,67 @@
+#ifndef ACTIONBUTTONDELEGATE_H
+#define ACTIONBUTTONDELEGATE_H
+
+#include <QStyledItemDelegate>
+#include <QPersistentModelIndex>
+#include <QColor>
+#include <QVector>
+#include <functional>
+
+class QAbstractItemView;
+
+struct ActionButton {
+    QString text;
+    QColor color;
+    QColor hoverColor;
+    QString toolTip;
+};
+
+// Tablo satırlarındaki işlem butonlarını (Onayla/Reddet, Silme İsteği) widget oluşturmadan
+// çizen ve tıklamayı konumdan çözen delegate. Satır başına QWidget + QPushButton + stil
+// ayrıştırma yerine tüm satırlar aynı nesneyle çizilir; binlerce satırda kaydırma akıcı kalır.
+class ActionButtonDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    // view: delegate'in bağlanacağı tablo; fare takibi açılır ve üzerine gelme efekti için kullanılır
+    ActionButtonDelegate(const QVector<ActionButton>& buttons, QAbstractItemView* view);
+
+    // Butonların hangi satırlarda gösterileceği (ör. sadece tamamlanmış yoklamalar), varsayılan hepsi
+    void setVisibleFunction(std::function<bool(const QModelIndex&)> visible) { m_visible = visible; }
+    void setCornerRadius(int radius) { m_cornerRadius = radius; }
+
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    bool editorEvent(QEvent* event, QAbstractItemModel* model, const QStyleOptionViewItem& option,
+                     const QModelIndex& index) override;
+    bool helpEvent(QHelpEvent* event, QAbstractItemView* view, const QStyleOptionViewItem& option,
+                   const QModelIndex& index) override;
+
+signals:
+    // Tıklama olay işleme bittikten sonra bildirilir; bağlı slot modeli güvenle yenileyebilir.
+    // index bırakma anında tıklanan satırı gösterir; arada satır eklenip silinirse yeni yerini izler,
+    // model sıfırlandıysa geçersizdir.
+    void buttonClicked(const QPersistentModelIndex& index, int button);
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    QVector<QRect> buttonRects(const QStyleOptionViewItem& option, const QModelIndex& index) const;
+    int buttonAt(const QStyleOptionViewItem& option, const QModelIndex& index, const QPoint& pos) const;
+    QFont buttonFont(const QFont& base) const;
+    void setHover(const QModelIndex& index, int button);
+
+    QVector<ActionButton> m_buttons;
+    QAbstractItemView* m_view;
+    std::function<bool(const QModelIndex&)> m_visible;
+    int m_cornerRadius;
+
+    QPersistentModelIndex m_hoverIndex;
+    int m_hoverButton;
+    QPersistentModelIndex m_pressedIndex;
+    int m_pressedButton;
+};
+
+#endif // ACTIONBUTTONDELEGATE_H
@@ -1,10 +1,12 @@
 #include "adminwidget.h"
 #include "./ui_adminwidget.h"
 #include "tablehelper.h"
+#include "actionbuttondelegate.h"
+#include "lazytabloader.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QTabWidget>
-#include <QTableWidget>
+#include <QTableView>
 #include <QPushButton>
 #include <QGroupBox>
 #include <QLabel>
@@ -18,6 +20,11 @@
 #include <QDebug>
 #include <QMenu>
 #include <QAction>
+#include <QElapsedTimer>
+
+namespace {
+const int kAttendancePageSize = 200; // Kaydırdıkça yüklenen yoklama özeti satırı
+}
 
 AdminWidget::AdminWidget(DatabaseManager& dbManager, const User& user, QWidget* parent)
     : QWidget(parent)
@@ -37,6 +44,13 @@ AdminWidget::~AdminWidget()
 
 void AdminWidget::setupConnections()
 {
+    // Girişte sadece açık sekme yüklenir; diğerleri ilk açıldıklarında, veri değişince yeniden
+    m_tabLoader = new LazyTabLoader(ui->tabWidget);
+    m_tabLoader->setLoader(ui->attendanceTab, [this]() { loadAttendanceData(); });
+    m_tabLoader->setLoader(ui->deleteRequestsTab, [this]() { loadDeleteRequestsData(); });
+    m_tabLoader->setLoader(ui->teacherManagementTab, [this]() { loadTeachersData(); });
+    m_tabLoader->setLoader(ui->courseManagementTab, [this]() { loadCoursesData(); });
+    
     // Çıkış butonu
     connect(ui->logoutButton, &QPushButton::clicked, this, [this]() {
         emit logoutRequested();
@@ -44,14 +58,14 @@ void AdminWidget::setupConnections()
     
     // Öğretmen yönetimi
     connect(ui->addTeacherButton, &QPushButton::clicked, this, &AdminWidget::onAddTeacherClicked);
-    connect(ui->teachersTable, &QTableWidget::customContextMenuRequested, 
+    connect(ui->teachersTable, &QTableView::customContextMenuRequested, 
             this, &AdminWidget::onTeacherTableContextMenu);
     
     // Ders yönetimi
     connect(ui->addCourseButton, &QPushButton::clicked, this, &AdminWidget::onAddCourseClicked);
     
     // Yoklama yönetimi
-    connect(ui->attendanceTable, &QTableWidget::cellDoubleClicked, 
+    connect(ui->attendanceTable, &QTableView::doubleClicked, 
             this, &AdminWidget::onAttendanceTableDoubleClicked);
     
     // Tablo başlıklarını ayarla
@@ -64,28 +78,66 @@ void AdminWidget::setupConnections()
 void AdminWidget::setupTableHeaders()
 {
     // Yoklama tablosu başlıkları
-    ui->attendanceTable->setColumnCount(5);
-    ui->attendanceTable->setHorizontalHeaderLabels({
-        "Yoklama Başlığı", "Öğretmen", "Tarih", "Başlangıç", "Durum"
+    m_attendanceModel = new RecordTableModel<AdminAttendanceOverview>({
+        {"Yoklama Başlığı", [](const AdminAttendanceOverview& session) { return session.sessionTitle; }},
+        {"Öğretmen", [](const AdminAttendanceOverview& session) { return session.teacherName; }},
+        {"Tarih", [](const AdminAttendanceOverview& session) { return session.date; }},
+        {"Başlangıç", [](const AdminAttendanceOverview& session) { return session.startTime; }},
+        {"Durum", [](const AdminAttendanceOverview& session) {
+            return QString(session.status == "active" ? "Aktif" : "Tamamlandı");
+        }}
+    }, this);
+    ui->attendanceTable->setModel(m_attendanceModel);
+    // Tablo sona yaklaşınca sonraki sayfa istenir
+    m_attendanceModel->setFetchMoreFunction([this]() {
+        fetchAttendancePage(m_attendanceLoadId);
     });
     
     // Silme istekleri tablosu başlıkları
-    ui->deleteRequestsTable->setColumnCount(6);
-    ui->deleteRequestsTable->setHorizontalHeaderLabels({
-        "Yoklama Başlığı", "Öğretmen", "İstek Tarihi", "Sebep", "Durum", "İşlemler"
+    m_deleteRequestsModel = new RecordTableModel<AttendanceDeleteRequest>({
+        {"Yoklama Başlığı", [](const AttendanceDeleteRequest& request) { return request.sessionTitle; }},
+        {"Öğretmen", [](const AttendanceDeleteRequest& request) { return request.teacherName; }},
+        {"İstek Tarihi", [](const AttendanceDeleteRequest& request) { return request.requestedAt; }},
+        {"Sebep", [](const AttendanceDeleteRequest& request) { return request.reason; }},
+        {"Durum", [](const AttendanceDeleteRequest&) { return QString("Beklemede"); }},
+        {"İşlemler", nullptr}
+    }, this);
+    ui->deleteRequestsTable->setModel(m_deleteRequestsModel);
+    
+    // Onay/Red Butonları
+    auto* requestActions = new ActionButtonDelegate({
+        {"Onayla", QColor("#27ae60"), QColor("#2ecc71"), QString()},
+        {"Reddet", QColor("#e74c3c"), QColor("#ec7063"), QString()}
+    }, ui->deleteRequestsTable);
+    requestActions->setCornerRadius(3);
+    ui->deleteRequestsTable->setItemDelegateForColumn(5, requestActions);
+    connect(requestActions, &ActionButtonDelegate::buttonClicked, this,
+            [this](const QPersistentModelIndex& index, int button) {
+        if (!index.isValid()) return; // Liste bu arada yenilendi
+        int requestId = m_deleteRequestsModel->record(index.row()).requestId;
+        if (button == 0) {
+            approveDeleteRequest(requestId);
+        } else {
+            rejectDeleteRequest(requestId);
+        }
     });
     
     // Öğretmenler tablosu başlıkları
-    ui->teachersTable->setColumnCount(3);
-    ui->teachersTable->setHorizontalHeaderLabels({
-        "Kullanıcı Adı", "Ad Soyad", "E-posta"
-    });
+    m_teachersModel = new RecordTableModel<Teacher>({
+        {"Kullanıcı Adı", [](const Teacher& teacher) { return teacher.username; }},
+        {"Ad Soyad", [](const Teacher& teacher) { return teacher.fullName; }},
+        {"E-posta", [](const Teacher& teacher) { return teacher.email; }}
+    }, this);
+    ui->teachersTable->setModel(m_teachersModel);
     
     // Dersler tablosu başlıkları
-    ui->coursesTable->setColumnCount(4);
-    ui->coursesTable->setHorizontalHeaderLabels({
-        "Ders Adı", "Ders Kodu", "Öğretmen", "Durum"
-    });
+    m_coursesModel = new RecordTableModel<CourseWithTeacher>({
+        {"Ders Adı", [](const CourseWithTeacher& course) { return course.courseName; }},
+        {"Ders Kodu", [](const CourseWithTeacher& course) { return course.courseCode; }},
+        {"Öğretmen", [](const CourseWithTeacher& course) { return course.teacherName; }},
+        {"Durum", [](const CourseWithTeacher&) { return QString("Aktif"); }}
+    }, this);
+    ui->coursesTable->setModel(m_coursesModel);
     
     // Tablo özelliklerini ayarla
     ui->attendanceTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
@@ -107,10 +159,7 @@ void AdminWidget::setupTableHeaders()
 
 void AdminWidget::loadData()
 {
-    loadAttendanceData();
-    loadDeleteRequestsData();
-    loadTeachersData();
-    loadCoursesData();
+    m_tabLoader->start();
 }
 
 void AdminWidget::onAddTeacherClicked()
@@ -131,7 +180,8 @@ void AdminWidget::onAddTeacherClicked()
         ui->teacherFullNameEdit->clear();
         ui->teacherEmailEdit->clear();
         loadTeachersData();
-        loadCoursesData();
+        // Ders sekmesindeki öğretmen listesi
+        m_tabLoader->markStale(ui->courseManagementTab);
     } else {
         QMessageBox::critical(this, "Hata", "Öğretmen eklenirken bir hata oluştu.");
     }
@@ -139,17 +189,7 @@ void AdminWidget::onAddTeacherClicked()
 
 void AdminWidget::loadTeachersData()
 {
-    QVector<Teacher> teachers = m_dbManager.getAllTeachers();
-    ui->teachersTable->setRowCount(teachers.count());
-    for (int i = 0; i < teachers.count(); ++i) {
-        const auto& t = teachers[i];
-        QTableWidgetItem* usernameItem = new QTableWidgetItem(t.username);
-        QTableWidgetItem* nameItem = new QTableWidgetItem(t.fullName);
-        QTableWidgetItem* emailItem = new QTableWidgetItem(t.email);
-        ui->teachersTable->setItem(i, 0, usernameItem);
-        ui->teachersTable->setItem(i, 1, nameItem);
-        ui->teachersTable->setItem(i, 2, emailItem);
-    }
+    m_teachersModel->setRecords(m_dbManager.getAllTeachers());
     TableHelper::resizeColumnsToContent(ui->teachersTable);
 }
 
@@ -183,21 +223,10 @@ void AdminWidget::loadCoursesData()
     QVector<CourseWithTeacher> courses = m_dbManager.getAllCoursesWithTeachers();
     qDebug() << "Yüklenen ders sayısı:" << courses.count();
     
-    ui->coursesTable->setRowCount(courses.count());
-    
-    for (int i = 0; i < courses.count(); ++i) {
-        const auto& course = courses[i];
+    for (const auto& course : courses) {
         qDebug() << "Ders:" << course.courseName << "Öğretmen:" << course.teacherName;
-        QTableWidgetItem* nameItem = new QTableWidgetItem(course.courseName);
-        QTableWidgetItem* codeItem = new QTableWidgetItem(course.courseCode);
-        QTableWidgetItem* teacherItem = new QTableWidgetItem(course.teacherName);
-        QTableWidgetItem* statusItem = new QTableWidgetItem("Aktif");
-        
-        ui->coursesTable->setItem(i, 0, nameItem);
-        ui->coursesTable->setItem(i, 1, codeItem);
-        ui->coursesTable->setItem(i, 2, teacherItem);
-        ui->coursesTable->setItem(i, 3, statusItem);
     }
+    m_coursesModel->setRecords(courses);
     
     TableHelper::resizeColumnsToContent(ui->coursesTable);
     
@@ -214,91 +243,65 @@ void AdminWidget::loadAttendanceData()
     // Debug bilgilerini göster
     m_dbManager.debugDatabaseTables();
     
-    QVector<AdminAttendanceOverview> sessions = m_dbManager.getAdminAttendanceOverview();
-    
-    ui->attendanceTable->setRowCount(sessions.count());
-    
-    for (int i = 0; i < sessions.count(); ++i) {
-        const auto& session = sessions[i];
-        
-        QTableWidgetItem* titleItem = new QTableWidgetItem(session.sessionTitle);
-        titleItem->setData(Qt::UserRole, session.sessionId);
-        ui->attendanceTable->setItem(i, 0, titleItem);
-        
-        QTableWidgetItem* teacherItem = new QTableWidgetItem(session.teacherName);
-        ui->attendanceTable->setItem(i, 1, teacherItem);
+    // Büyük yoklama geçmişlerinde sorgu arayüzü ve kart okuyucuyu bekletmesin diye
+    // arka planda ve sayfa sayfa yüklenir; ilk sayfa gelince tablo kullanılabilir
+    TableHelper::setLoading(ui->attendanceTable, true);
+    int loadId = ++m_attendanceLoadId;
+    m_attendanceCursor = SessionPageCursor();
+    m_attendanceModel->clear();
+    fetchAttendancePage(loadId);
+}
+
+void AdminWidget::fetchAttendancePage(int loadId)
+{
+    // Süreler sayfa başına sorgu ve tablo doldurma maliyetini ölçmek için loglanır
+    QElapsedTimer timer;
+    timer.start();
+    SessionPageCursor cursor = m_attendanceCursor;
+    
+    m_dbManager.runAsync([cursor](DatabaseManager& db) {
+        return db.getAdminAttendanceOverviewPage(cursor, kAttendancePageSize);
+    }).then(this, [this, loadId, timer](SessionPage<AdminAttendanceOverview> page) {
+        // Bu arada yeni bir yükleme başladıysa eski sonuç atılır
+        if (loadId != m_attendanceLoadId) return;
+        qint64 queryMs = timer.elapsed();
         
-        QTableWidgetItem* dateItem = new QTableWidgetItem(session.date);
-        ui->attendanceTable->setItem(i, 2, dateItem);
+        QElapsedTimer stepTimer;
+        stepTimer.start();
+        int firstRow = m_attendanceModel->rowCount();
+        m_attendanceCursor = page.next;
+        m_attendanceModel->appendRecords(page.rows, page.hasMore);
+        qint64 fillMs = stepTimer.restart();
         
-        QTableWidgetItem* startItem = new QTableWidgetItem(session.startTime);
-        ui->attendanceTable->setItem(i, 3, startItem);
+        // İlk sayfada genişlikler örneklenir, sonraki sayfalar sadece yeni satırlara bakar
+        if (firstRow == 0) {
+            TableHelper::resizeColumnsToContent(ui->attendanceTable);
+            TableHelper::setLoading(ui->attendanceTable, false);
+        } else {
+            for (int row = firstRow; row < m_attendanceModel->rowCount(); ++row) {
+                TableHelper::growColumnsForRow(ui->attendanceTable, row);
+            }
+        }
+        qint64 resizeMs = stepTimer.elapsed();
         
-        QTableWidgetItem* statusItem = new QTableWidgetItem(
-            session.status == "active" ? "Aktif" : "Tamamlandı");
-        ui->attendanceTable->setItem(i, 4, statusItem);
-    }
-    
-    TableHelper::resizeColumnsToContent(ui->attendanceTable);
+        qDebug() << "Yoklama özeti sayfası yüklendi:" << page.rows.count() << "satır (toplam"
+                 << m_attendanceModel->rowCount() << "), sorgu" << queryMs << "ms, model" << fillMs
+                 << "ms, sütun genişlikleri" << resizeMs << "ms";
+    });
 }
 
 void AdminWidget::loadDeleteRequestsData()
 {
     QVector<AttendanceDeleteRequest> requests = m_dbManager.getPendingDeleteRequests();
-    
-    ui->deleteRequestsTable->setRowCount(requests.count());
-    
-    for (int i = 0; i < requests.count(); ++i) {
-        const auto& request = requests[i];
-        
-        QTableWidgetItem* titleItem = new QTableWidgetItem(request.sessionTitle);
-        ui->deleteRequestsTable->setItem(i, 0, titleItem);
-        
-        QTableWidgetItem* teacherItem = new QTableWidgetItem(request.teacherName);
-        ui->deleteRequestsTable->setItem(i, 1, teacherItem);
-        
-        QTableWidgetItem* dateItem = new QTableWidgetItem(request.requestedAt);
-        ui->deleteRequestsTable->setItem(i, 2, dateItem);
-        
-        QTableWidgetItem* reasonItem = new QTableWidgetItem(request.reason);
-        ui->deleteRequestsTable->setItem(i, 3, reasonItem);
-        
-        QTableWidgetItem* statusItem = new QTableWidgetItem("Beklemede");
-        ui->deleteRequestsTable->setItem(i, 4, statusItem);
-        
-        // Onay/Red Butonları
-        QWidget* buttonWidget = new QWidget();
-        QHBoxLayout* buttonLayout = new QHBoxLayout(buttonWidget);
-        buttonLayout->setContentsMargins(2, 2, 2, 2);
-        
-        QPushButton* approveButton = new QPushButton("Onayla");
-        approveButton->setStyleSheet("QPushButton { background: #27ae60; color: white; border: none; padding: 5px; border-radius: 3px; }");
-        connect(approveButton, &QPushButton::clicked, [this, request]() {
-            approveDeleteRequest(request.requestId);
-        });
-        
-        QPushButton* rejectButton = new QPushButton("Reddet");
-        rejectButton->setStyleSheet("QPushButton { background: #e74c3c; color: white; border: none; padding: 5px; border-radius: 3px; }");
-        connect(rejectButton, &QPushButton::clicked, [this, request]() {
-            rejectDeleteRequest(request.requestId);
-        });
-        
-        buttonLayout->addWidget(approveButton);
-        buttonLayout->addWidget(rejectButton);
-        buttonLayout->addStretch();
-        
-        ui->deleteRequestsTable->setCellWidget(i, 5, buttonWidget);
-    }
+    m_deleteRequestsModel->setRecords(requests);
     
     TableHelper::resizeColumnsToContent(ui->deleteRequestsTable);
 }
 
-void AdminWidget::onAttendanceTableDoubleClicked(int row, int column)
+void AdminWidget::onAttendanceTableDoubleClicked(const QModelIndex& index)
 {
-    QTableWidgetItem* item = ui->attendanceTable->item(row, 0);
-    if (item) {
-        int sessionId = item->data(Qt::UserRole).toInt();
-        showAttendanceDetails(sessionId);
+    if (index.isValid()) {
+        showAttendanceDetails(m_attendanceModel->record(index.row()).sessionId);
     }
 }
 
@@ -318,24 +321,20 @@ void AdminWidget::showAttendanceDetails(int sessionId)
     
     QVBoxLayout* layout = new QVBoxLayout(dialog);
     
-    QTableWidget* detailTable = new QTableWidget();
-    detailTable->setColumnCount(4);
-    detailTable->setHorizontalHeaderLabels({"Öğrenci No", "Ad", "Soyad", "Yoklama Zamanı"});
+    auto* detailModel = new RecordTableModel<AttendanceRecord>({
+        {"Öğrenci No", [](const AttendanceRecord& record) { return record.studentNumber; }},
+        {"Ad", [](const AttendanceRecord& record) { return record.firstName; }},
+        {"Soyad", [](const AttendanceRecord& record) { return record.lastName; }},
+        {"Yoklama Zamanı", [](const AttendanceRecord& record) { return record.time; }}
+    }, dialog);
+    detailModel->setRecords(records);
+    
+    QTableView* detailTable = new QTableView();
+    detailTable->setModel(detailModel);
     detailTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
     detailTable->setSelectionBehavior(QAbstractItemView::SelectRows);
     detailTable->setAlternatingRowColors(true);
     
-    detailTable->setRowCount(records.count());
-    for (int i = 0; i < records.count(); ++i) {
-        const auto& record = records[i];
-        detailTable->setItem(i, 0, new QTableWidgetItem(record.studentNumber));
-        detailTable->setItem(i, 1, new QTableWidgetItem(record.firstName));
-        detailTable->setItem(i, 2, new QTableWidgetItem(record.lastName));
-        detailTable->setItem(i, 3, new QTableWidgetItem(record.time));
-        
-        qDebug() << "Tablo satırı" << i << ":" << record.firstName << record.lastName << record.time;
-    }
-    
     TableHelper::resizeColumnsToContent(detailTable);
     layout->addWidget(detailTable);
     
@@ -352,6 +351,8 @@ void AdminWidget::approveDeleteRequest(int requestId)
     if (success) {
         QMessageBox::information(this, "Başarılı", "Silme isteği onaylandı.");
         loadDeleteRequestsData();
+        // Silinen yoklama özetten de kalkar
+        m_tabLoader->markStale(ui->attendanceTab);
     } else {
         QMessageBox::critical(this, "Hata", "İstek onaylanırken hata oluştu.");
     }
@@ -380,7 +381,7 @@ void AdminWidget::onTeacherTableContextMenu(const QPoint& pos)
     
     QAction* changePasswordAction = new QAction("Şifre Değiştir", this);
     connect(changePasswordAction, &QAction::triggered, [this]() {
-        int currentRow = ui->teachersTable->currentRow();
+        int currentRow = ui->teachersTable->currentIndex().row();
         if (currentRow >= 0) {
             changeTeacherPassword(currentRow);
         }
@@ -398,13 +399,10 @@ void AdminWidget::onTeacherTableContextMenu(const QPoint& pos)
 void AdminWidget::changeTeacherPassword(int row)
 {
     // Seçili öğretmenin bilgilerini al
-    QTableWidgetItem* usernameItem = ui->teachersTable->item(row, 0);
-    QTableWidgetItem* nameItem = ui->teachersTable->item(row, 1);
-    
-    if (!usernameItem || !nameItem) return;
+    if (row < 0 || row >= m_teachersModel->rowCount()) return;
     
-    QString username = usernameItem->text();
-    QString teacherName = nameItem->text();
+    QString username = m_teachersModel->record(row).username;
+    QString teacherName = m_teachersModel->record(row).fullName;
     
     bool ok;
     QString newPassword = QInputDialog::getText(this, "Şifre Değiştir",
@@ -424,19 +422,14 @@ void AdminWidget::changeTeacherPassword(int row)
 void AdminWidget::removeTeacher()
 {
     // Seçili satırı al
-    int currentRow = ui->teachersTable->currentRow();
+    int currentRow = ui->teachersTable->currentIndex().row();
     if (currentRow < 0) {
         QMessageBox::warning(this, "Uyarı", "Lütfen silinecek öğretmeni seçin.");
         return;
     }
     
-    QTableWidgetItem* usernameItem = ui->teachersTable->item(currentRow, 0);
-    QTableWidgetItem* nameItem = ui->teachersTable->item(currentRow, 1);
-    
-    if (!usernameItem || !nameItem) return;
-    
-    QString username = usernameItem->text();
-    QString teacherName = nameItem->text();
+    QString username = m_teachersModel->record(currentRow).username;
+    QString teacherName = m_teachersModel->record(currentRow).fullName;
     
     QMessageBox::StandardButton reply = QMessageBox::question(this, "Onay",
         QString("Öğretmen '%1' silinecek. Emin misiniz?").arg(teacherName),
@@ -447,7 +440,8 @@ void AdminWidget::removeTeacher()
         if (success) {
             QMessageBox::information(this, "Başarılı", "Öğretmen başarıyla silindi.");
             loadTeachersData();
-            loadCoursesData();
+            m_tabLoader->markStale(ui->courseManagementTab);
+            m_tabLoader->markStale(ui->attendanceTab);
         } else {
             QMessageBox::critical(this, "Hata", "Öğretmen silinirken hata oluştu.");
         }
@@ -2,18 +2,21 @@
 #define ADMINWIDGET_H
 
 #include <QWidget>
-#include <QTableWidget>
+#include <QTableView>
 #include <QPushButton>
 #include <QGroupBox>
 #include <QLabel>
 #include <QLineEdit>
 #include <QComboBox>
 #include "databasemanager.h"
+#include "recordtablemodel.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class AdminWidget; }
 QT_END_NAMESPACE
 
+class LazyTabLoader;
+
 class AdminWidget : public QWidget
 {
     Q_OBJECT
@@ -26,7 +29,7 @@ signals:
     void logoutRequested();
 
 private slots:
-    void onAttendanceTableDoubleClicked(int row, int column);
+    void onAttendanceTableDoubleClicked(const QModelIndex& index);
     void approveDeleteRequest(int requestId);
     void rejectDeleteRequest(int requestId);
     void onAddTeacherClicked();
@@ -41,6 +44,7 @@ private:
     void setupTableHeaders();
     void loadData();
     void loadAttendanceData();
+    void fetchAttendancePage(int loadId);
     void loadDeleteRequestsData();
     void showAttendanceDetails(int sessionId);
     void loadTeachersData();
@@ -49,6 +53,13 @@ private:
     Ui::AdminWidget *ui;
     DatabaseManager& m_dbManager;
     User m_currentUser;
+    RecordTableModel<AdminAttendanceOverview>* m_attendanceModel;
+    RecordTableModel<AttendanceDeleteRequest>* m_deleteRequestsModel;
+    RecordTableModel<Teacher>* m_teachersModel;
+    RecordTableModel<CourseWithTeacher>* m_coursesModel;
+    LazyTabLoader* m_tabLoader = nullptr; // Sekmeler ilk açıldıklarında yüklenir
+    int m_attendanceLoadId = 0; // Son başlatılan arka plan yüklemesi
+    SessionPageCursor m_attendanceCursor; // Yüklenen son yoklama özeti satırı
 };
 
 #endif // ADMINWIDGET_H 
\ No newline at end of file
@@ -0,0 +1,340 @@
+#include "attendancewriter.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDateTime>
+#include <QDeadlineTimer>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QDebug>
+
+namespace {
+const char* const kWriterConnectionName = "yoklama_writer_connection";
+// Kilit ya da geçici G/Ç hatasında grup kısa aralıklarla tekrar denenir
+const int kMaxCommitAttempts = 3;
+const int kRetryDelayMs = 100;
+}
+
+AttendanceWriter::AttendanceWriter(const QString& databasePath, QObject* parent)
+    : QThread(parent)
+    , m_databasePath(databasePath)
+    , m_legacyJournalPath(QFileInfo(databasePath).absolutePath() + "/yoklama_tap_journal.log")
+    , m_journal(QFileInfo(databasePath).absolutePath() + "/yoklama_tap_journal.dat")
+    , m_enqueuedSeq(0)
+    , m_committedSeq(0)
+    , m_lastFailedSeq(0)
+    , m_stopping(false)
+    , m_flushRequested(false)
+    , m_journalFailureReported(false)
+    , m_durability(WriteDurability::Journaled)
+    , m_intervalMs(250)
+    , m_maxBatch(64)
+{
+    if (!m_journal.open()) {
+        // Günlük modundaki kayıtlar enqueue içinde commit beklenerek yazılır
+        qDebug() << "Okutma günlüğü açılamadı:" << m_journal.path();
+    }
+}
+
+AttendanceWriter::~AttendanceWriter()
+{
+    stop();
+}
+
+void AttendanceWriter::setDurability(WriteDurability durability)
+{
+    QMutexLocker locker(&m_mutex);
+    m_durability = durability;
+    m_wakeWriter.wakeOne();
+}
+
+WriteDurability AttendanceWriter::durability() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_durability;
+}
+
+void AttendanceWriter::setBatchLimits(int intervalMs, int maxRecords)
+{
+    QMutexLocker locker(&m_mutex);
+    m_intervalMs = qMax(1, intervalMs);
+    m_maxBatch = qMax(1, maxRecords);
+}
+
+bool AttendanceWriter::enqueue(int sessionId, int studentId, const CardUid& uid)
+{
+    QDateTime now = QDateTime::currentDateTime();
+    PendingAttendance record{sessionId, studentId, now.toString(Qt::ISODate), uid, now.toMSecsSinceEpoch()};
+
+    QMutexLocker locker(&m_mutex);
+    bool waitForCommit = m_durability == WriteDurability::Strict;
+    bool reportJournalFailure = false;
+    if (m_durability == WriteDurability::Journaled
+        && !m_journal.append(sessionId, studentId, uid, record.wallMs)) {
+        // Günlüğe girmeyen kayıt çökmeye karşı korunmuyor; geri bildirimden önce commit beklenir
+        waitForCommit = true;
+        m_flushRequested = true;
+        reportJournalFailure = !m_journalFailureReported;
+        m_journalFailureReported = true;
+    }
+
+    record.awaited = waitForCommit;
+    m_queue.append(record);
+    qint64 seq = ++m_enqueuedSeq;
+    m_stats.queueDepth = m_queue.count();
+    m_stats.maxQueueDepth = qMax(m_stats.maxQueueDepth, m_stats.queueDepth);
+    m_wakeWriter.wakeOne();
+
+    if (reportJournalFailure) {
+        QString error = QString("Okutma günlüğüne yazılamadı (%1), kayıtlar commit beklenerek yazılıyor")
+                            .arg(m_journal.path());
+        qWarning() << error;
+        locker.unlock();
+        emit writeFailed(error);
+        locker.relock();
+    }
+
+    if (!waitForCommit) {
+        return true;
+    }
+
+    // Strict ya da günlüğe yazılamadı: kaydın commit edilmesini bekle
+    while (m_committedSeq < seq && !m_stopping && isRunning()) {
+        m_committed.wait(&m_mutex);
+    }
+    return m_committedSeq >= seq && m_lastFailedSeq < seq;
+}
+
+void AttendanceWriter::flush()
+{
+    QMutexLocker locker(&m_mutex);
+    qint64 target = m_enqueuedSeq;
+    m_flushRequested = true;
+    m_wakeWriter.wakeOne();
+    while (m_committedSeq < target && isRunning() && !m_stopping) {
+        m_committed.wait(&m_mutex);
+    }
+}
+
+void AttendanceWriter::stop()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping = true;
+        m_wakeWriter.wakeOne();
+    }
+    // Kuyrukta kalanlar çıkmadan önce yazılır
+    wait();
+}
+
+AttendanceWriterStats AttendanceWriter::stats() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_stats;
+}
+
+TapJournalStats AttendanceWriter::journalStats() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_journal.stats();
+}
+
+void AttendanceWriter::run()
+{
+    {
+        // Bağlantı sadece bu thread'de kullanılır
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", kWriterConnectionName);
+        db.setDatabaseName(m_databasePath);
+        if (!db.open()) {
+            qDebug() << "Yoklama yazıcısı veritabanını açamadı:" << db.lastError().text();
+            emit writeFailed(db.lastError().text());
+        } else {
+            QMutexLocker locker(&m_mutex);
+            replayLegacyJournal(db);
+            replayJournal(db);
+
+            while (true) {
+                while (m_queue.isEmpty() && !m_stopping) {
+                    m_wakeWriter.wait(&m_mutex);
+                }
+                if (m_queue.isEmpty() && m_stopping) break;
+
+                // Grup penceresi: eşik dolana, süre bitene ya da flush istenene kadar biriktir
+                if (m_durability != WriteDurability::Strict) {
+                    QDeadlineTimer deadline(m_intervalMs);
+                    while (m_queue.count() < m_maxBatch && !m_stopping && !m_flushRequested
+                           && m_durability != WriteDurability::Strict) {
+                        if (!m_wakeWriter.wait(&m_mutex, deadline)) break;
+                    }
+                }
+
+                // Açılışta yazılamamış günlük kayıtları yeni okutmalarla birlikte denenir
+                QVector<PendingAttendance> batch;
+                batch.swap(m_recovered);
+                batch += m_queue;
+                m_queue.clear();
+                qint64 batchEndSeq = m_enqueuedSeq;
+                m_flushRequested = false;
+                m_stats.queueDepth = 0;
+
+                locker.unlock();
+                QElapsedTimer commitTimer;
+                commitTimer.start();
+                bool ok = false;
+                QString error;
+                int attempt = 1;
+                for (; attempt <= kMaxCommitAttempts; ++attempt) {
+                    if (attempt > 1) {
+                        QThread::msleep(kRetryDelayMs * (attempt - 1));
+                    }
+                    ok = commitBatch(db, batch, &error);
+                    if (ok) break;
+                }
+                qint64 latencyUs = commitTimer.nsecsElapsed() / 1000;
+                locker.relock();
+
+                m_committedSeq = batchEndSeq;
+                QVector<PendingAttendance> failed;
+                if (ok) {
+                    m_stats.committedRecords += batch.count();
+                    if (attempt > 1) {
+                        m_stats.retriedCommits++;
+                    }
+                    // Günlük yalnızca bekleyen kayıt kalmadığında temizlenir
+                    if (m_queue.isEmpty() && m_recovered.isEmpty()) {
+                        m_journal.compact();
+                    }
+                } else {
+                    m_lastFailedSeq = batchEndSeq;
+                    m_stats.failedCommits++;
+                    // Canlı okutmalar arayüzde geri alınır ve tekrar okutulması istenir; günlükte
+                    // kalırlarsa sonraki açılışta sessizce yazılırlardı. Kurtarılan kayıtların geri
+                    // alınacak bir arayüzü yok, bir sonraki grupla tekrar denenir.
+                    for (const PendingAttendance& record : batch) {
+                        if (record.recovered) {
+                            m_recovered.append(record);
+                        } else {
+                            failed.append(record);
+                        }
+                    }
+                    m_stats.failedRecords += failed.count();
+                    rewriteJournal();
+                }
+                m_stats.commitCount++;
+                m_stats.lastCommitUs = latencyUs;
+                m_stats.maxCommitUs = qMax(m_stats.maxCommitUs, latencyUs);
+                m_stats.totalCommitUs += latencyUs;
+                m_committed.wakeAll();
+
+                locker.unlock();
+                if (ok) {
+                    emit batchCommitted(batch.count(), latencyUs);
+                } else {
+                    emit writeFailed(error);
+                    // Arayüz bu öğrencileri "var" göstermişti; geri alıp tekrar okutulmasını ister.
+                    // Commit'i bekleyen enqueue (Strict) zaten false döndü, okutma hiç "var" sayılmadı.
+                    for (const PendingAttendance& record : failed) {
+                        if (!record.awaited) {
+                            emit recordFailed(record.sessionId, record.studentId, error);
+                        }
+                    }
+                }
+                locker.relock();
+            }
+            db.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(kWriterConnectionName);
+
+    QMutexLocker locker(&m_mutex);
+    m_committedSeq = m_enqueuedSeq;
+    m_committed.wakeAll();
+}
+
+bool AttendanceWriter::commitBatch(QSqlDatabase& db, const QVector<PendingAttendance>& batch, QString* error)
+{
+    if (!db.transaction()) {
+        qDebug() << "Yoklama grubu için transaction açılamadı:" << db.lastError().text();
+        if (error) *error = db.lastError().text();
+        return false;
+    }
+
+    QSqlQuery query(db);
+    query.prepare("INSERT OR IGNORE INTO attendanceRecords (sessionId, studentId, time, status) "
+                  "VALUES (:sessionId, :studentId, :time, 'present')");
+    for (const auto& record : batch) {
+        query.bindValue(":sessionId", record.sessionId);
+        query.bindValue(":studentId", record.studentId);
+        query.bindValue(":time", record.time);
+        if (!query.exec()) {
+            qDebug() << "Yoklama grubu yazılamadı:" << query.lastError().text();
+            if (error) *error = query.lastError().text();
+            db.rollback();
+            return false;
+        }
+    }
+
+    if (!db.commit()) {
+        qDebug() << "Yoklama grubu commit edilemedi:" << db.lastError().text();
+        if (error) *error = db.lastError().text();
+        db.rollback();
+        return false;
+    }
+    return true;
+}
+
+void AttendanceWriter::replayJournal(QSqlDatabase& db)
+{
+    QVector<TapJournalEntry> entries = m_journal.pendingEntries();
+    if (entries.isEmpty()) return;
+
+    QVector<PendingAttendance> pending;
+    pending.reserve(entries.count());
+    for (const TapJournalEntry& entry : entries) {
+        pending.append({entry.sessionId, entry.studentId,
+                        QDateTime::fromMSecsSinceEpoch(entry.wallMs).toString(Qt::ISODate),
+                        entry.uid, entry.wallMs, true});
+    }
+
+    // UNIQUE(sessionId, studentId) sayesinde zaten yazılmış kayıtlar tekrar eklenmez
+    QString error;
+    if (commitBatch(db, pending, &error)) {
+        qDebug() << "Okutma günlüğünden kurtarılan kayıt sayısı:" << pending.count();
+        m_journal.compact();
+    } else {
+        // Günlükte kalırlar; ilk yeni grupla birlikte tekrar denenir
+        qDebug() << "Okutma günlüğü oynatılamadı, kayıtlar sonraki grupla denenecek:" << error;
+        m_recovered = pending;
+    }
+}
+
+void AttendanceWriter::rewriteJournal()
+{
+    // Günlükte sadece henüz yazılmamış ve vazgeçilmemiş kayıtlar kalır
+    if (!m_journal.isOpen() || m_journal.pendingCount() == 0) return;
+
+    m_journal.compact();
+    for (const PendingAttendance& record : m_recovered + m_queue) {
+        m_journal.append(record.sessionId, record.studentId, record.uid, record.wallMs);
+    }
+}
+
+void AttendanceWriter::replayLegacyJournal(QSqlDatabase& db)
+{
+    // Eski sürümün metin günlüğü ("oturum;öğrenci;zaman" satırları) bir kez oynatılıp silinir
+    QFile file(m_legacyJournalPath);
+    if (!file.open(QIODevice::ReadOnly)) return;
+
+    QVector<PendingAttendance> pending;
+    while (!file.atEnd()) {
+        QList<QByteArray> fields = file.readLine().trimmed().split(';');
+        if (fields.count() != 3) continue; // Yarım kalmış satır
+        pending.append({fields[0].toInt(), fields[1].toInt(), QString::fromLatin1(fields[2])});
+    }
+    file.close();
+
+    if (pending.isEmpty() || commitBatch(db, pending)) {
+        qDebug() << "Eski yoklama günlüğünden kurtarılan kayıt sayısı:" << pending.count();
+        QFile::remove(m_legacyJournalPath);
+    }
+}
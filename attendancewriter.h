@@ -0,0 +1,106 @@
+#ifndef ATTENDANCEWRITER_H
+#define ATTENDANCEWRITER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QVector>
+#include <QString>
+#include <QSqlDatabase>
+#include "tapjournal.h"
+
+// Yoklama kaydı kalıcılık modları
+enum class WriteDurability {
+    Strict,     // Geri bildirimden önce commit beklenir
+    Grouped,    // Kayıtlar grup halinde yazılır, en fazla bir grup penceresi kaybolabilir
+    Journaled   // Kayıt önce belleğe eşlenmiş günlüğe eklenir, açılışta günlük tekrar oynatılır
+};
+
+struct PendingAttendance {
+    int sessionId;
+    int studentId;
+    QString time;
+    CardUid uid;
+    qint64 wallMs = 0;
+    bool recovered = false;  // Önceki açılışın günlüğünden; arayüzde karşılığı yok
+    bool awaited = false;    // enqueue commit'i bekledi, sonucu dönüş değeriyle bildirildi
+};
+
+struct AttendanceWriterStats {
+    int queueDepth = 0;
+    int maxQueueDepth = 0;
+    qint64 committedRecords = 0;
+    qint64 commitCount = 0;
+    qint64 failedCommits = 0;
+    qint64 retriedCommits = 0;   // Tekrar denemede başarılı olan gruplar
+    qint64 failedRecords = 0;    // Tüm denemelerden sonra yazılamayan kayıtlar
+    qint64 lastCommitUs = 0;
+    qint64 maxCommitUs = 0;
+    qint64 totalCommitUs = 0;
+};
+
+// Yoklama kayıtlarını arka planda kendi veritabanı bağlantısıyla,
+// her N ms'de ya da M kayıtta bir tek transaction içinde yazan sınıf.
+// SQLite'ta her kart okutma için ayrı fsync yapılmasını engeller.
+class AttendanceWriter : public QThread
+{
+    Q_OBJECT
+
+public:
+    explicit AttendanceWriter(const QString& databasePath, QObject* parent = nullptr);
+    ~AttendanceWriter();
+
+    void setDurability(WriteDurability durability);
+    WriteDurability durability() const;
+    void setBatchLimits(int intervalMs, int maxRecords);
+
+    // Kaydı kuyruğa ekler. Strict modda commit tamamlanana kadar bekler; Journaled modda
+    // günlüğe yazılamayan kayıt için de Strict gibi beklenir.
+    bool enqueue(int sessionId, int studentId, const CardUid& uid);
+    // Kuyruktaki tüm kayıtlar yazılana kadar bekler
+    void flush();
+    void stop();
+
+    AttendanceWriterStats stats() const;
+    TapJournalStats journalStats() const;
+
+signals:
+    void batchCommitted(int recordCount, qint64 latencyUs);
+    void writeFailed(const QString& error);
+    // Tüm denemelere rağmen yazılamayan kayıt; öğrenci yoklamaya alınmamış sayılmalı
+    void recordFailed(int sessionId, int studentId, const QString& error);
+
+protected:
+    void run() override;
+
+private:
+    // Hata durumunda error (verilmişse) başarısız çağrının hata metnini alır
+    bool commitBatch(QSqlDatabase& db, const QVector<PendingAttendance>& batch, QString* error = nullptr);
+    void rewriteJournal();
+    void replayJournal(QSqlDatabase& db);
+    void replayLegacyJournal(QSqlDatabase& db);
+
+    QString m_databasePath;
+    QString m_legacyJournalPath;
+    TapJournal m_journal;
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_wakeWriter;
+    QWaitCondition m_committed;
+
+    QVector<PendingAttendance> m_queue;
+    QVector<PendingAttendance> m_recovered; // Açılışta yazılamayan günlük kayıtları, sonraki grupla denenir
+    qint64 m_enqueuedSeq;
+    qint64 m_committedSeq;
+    qint64 m_lastFailedSeq;
+    bool m_stopping;
+    bool m_flushRequested;
+    bool m_journalFailureReported;
+
+    WriteDurability m_durability;
+    int m_intervalMs;
+    int m_maxBatch;
+    AttendanceWriterStats m_stats;
+};
+
+#endif // ATTENDANCEWRITER_H
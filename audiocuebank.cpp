@@ -0,0 +1,163 @@
+#include "audiocuebank.h"
+#include <QSoundEffect>
+#include <QDateTime>
+#include <QDataStream>
+#include <QFile>
+#include <QDir>
+#include <QUrl>
+#include <QDebug>
+#include <cmath>
+
+namespace {
+const int kSampleRate = 22050;
+const double kPi = 3.14159265358979323846;
+
+struct ToneSegment {
+    int frequencyHz; // 0: sessizlik
+    int durationMs;
+};
+}
+
+AudioCueBank::AudioCueBank(QObject* parent)
+    : QObject(parent)
+{
+    for (int cue = 0; cue < kCueCount; ++cue) {
+        m_nextVoice[cue] = 0;
+    }
+}
+
+void AudioCueBank::load(const QString& directory)
+{
+    for (int cue = 0; cue < kCueCount; ++cue) {
+        QString path = QDir(directory).filePath(cueFileName(static_cast<AudioCue>(cue)));
+        if (!QFile::exists(path)) {
+            path = generateTone(static_cast<AudioCue>(cue));
+        }
+        qDebug() << "Ses ipucu yükleniyor:" << path;
+
+        m_voices[cue].clear();
+        for (int voice = 0; voice < kVoicesPerCue; ++voice) {
+            QSoundEffect* effect = new QSoundEffect(this);
+            effect->setSource(QUrl::fromLocalFile(path));
+            connect(effect, &QSoundEffect::playingChanged, this, [this, cue, voice]() {
+                onPlayingChanged(cue, voice);
+            });
+            connect(effect, &QSoundEffect::statusChanged, this, [effect]() {
+                if (effect->status() == QSoundEffect::Error) {
+                    qDebug() << "Ses ipucu yüklenemedi:" << effect->source();
+                }
+            });
+            m_voices[cue].append({effect, 0});
+        }
+    }
+}
+
+void AudioCueBank::setVolume(qreal volume)
+{
+    for (int cue = 0; cue < kCueCount; ++cue) {
+        for (const Voice& voice : m_voices[cue]) {
+            voice.effect->setVolume(volume);
+        }
+    }
+}
+
+void AudioCueBank::play(AudioCue cue, qint64 detectedAtMs)
+{
+    QVector<Voice>& voices = m_voices[static_cast<int>(cue)];
+    if (voices.isEmpty()) return;
+    m_stats.requested++;
+
+    // Boşta bir kopya ara; hepsi çalıyorsa sıradaki (en eski) baştan başlatılır
+    int& next = m_nextVoice[static_cast<int>(cue)];
+    int index = next;
+    for (int i = 0; i < voices.count(); ++i) {
+        int candidate = (next + i) % voices.count();
+        if (!voices.at(candidate).effect->isPlaying()) {
+            index = candidate;
+            break;
+        }
+    }
+    next = (index + 1) % voices.count();
+
+    Voice& voice = voices[index];
+    if (voice.effect->isPlaying()) {
+        voice.effect->stop();
+        m_stats.restarted++;
+    }
+    voice.detectedAtMs = detectedAtMs;
+    voice.effect->play();
+}
+
+void AudioCueBank::onPlayingChanged(int cue, int voiceIndex)
+{
+    Voice& voice = m_voices[cue][voiceIndex];
+    if (!voice.effect->isPlaying() || voice.detectedAtMs <= 0) return;
+
+    qint64 latencyMs = QDateTime::currentMSecsSinceEpoch() - voice.detectedAtMs;
+    voice.detectedAtMs = 0;
+    m_stats.started++;
+    m_stats.totalDecodeToStartMs += latencyMs;
+    m_stats.maxDecodeToStartMs = qMax(m_stats.maxDecodeToStartMs, latencyMs);
+}
+
+QString AudioCueBank::cueFileName(AudioCue cue)
+{
+    switch (cue) {
+    case AudioCue::Present: return "success.wav";
+    case AudioCue::Duplicate: return "duplicate.wav";
+    case AudioCue::Unknown: return "unknown.wav";
+    case AudioCue::NotEnrolled: return "not_enrolled.wav";
+    }
+    return QString();
+}
+
+QString AudioCueBank::generateTone(AudioCue cue)
+{
+    // Ayırt edilebilir kısa tonlar: yükselen (var), tek kısa (tekrar), kalın çift (bilinmeyen),
+    // alçalan (kayıtsız)
+    QVector<ToneSegment> segments;
+    switch (cue) {
+    case AudioCue::Present: segments = {{880, 80}, {1320, 120}}; break;
+    case AudioCue::Duplicate: segments = {{1000, 60}}; break;
+    case AudioCue::Unknown: segments = {{300, 150}, {0, 60}, {300, 150}}; break;
+    case AudioCue::NotEnrolled: segments = {{660, 120}, {440, 180}}; break;
+    }
+
+    QDir dir(QDir::temp().filePath("yoklama_sesler"));
+    dir.mkpath(".");
+    QString path = dir.filePath(cueFileName(cue));
+    if (QFile::exists(path)) return path;
+
+    QByteArray samples;
+    QDataStream pcm(&samples, QIODevice::WriteOnly);
+    pcm.setByteOrder(QDataStream::LittleEndian);
+    for (const ToneSegment& segment : segments) {
+        int count = kSampleRate * segment.durationMs / 1000;
+        int fade = qMin(count / 4, kSampleRate / 200); // 5 ms yumuşak giriş/çıkış, tıklama olmasın
+        for (int i = 0; i < count; ++i) {
+            double envelope = qMin(1.0, qMin(i, count - 1 - i) / double(qMax(1, fade)));
+            double value = segment.frequencyHz > 0
+                ? std::sin(2.0 * kPi * segment.frequencyHz * i / kSampleRate) * envelope * 0.6
+                : 0.0;
+            pcm << static_cast<qint16>(value * 32767);
+        }
+    }
+
+    // 16 bit mono PCM WAV
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Ses ipucu yazılamadı:" << path << file.errorString();
+        return path;
+    }
+    QDataStream out(&file);
+    out.setByteOrder(QDataStream::LittleEndian);
+    out.writeRawData("RIFF", 4);
+    out << quint32(36 + samples.size());
+    out.writeRawData("WAVEfmt ", 8);
+    out << quint32(16) << quint16(1) << quint16(1) << quint32(kSampleRate)
+        << quint32(kSampleRate * 2) << quint16(2) << quint16(16);
+    out.writeRawData("data", 4);
+    out << quint32(samples.size());
+    out.writeRawData(samples.constData(), samples.size());
+    return path;
+}
@@ -0,0 +1,65 @@
+#ifndef AUDIOCUEBANK_H
+#define AUDIOCUEBANK_H
+
+#include <QObject>
+#include <QVector>
+#include <QString>
+
+class QSoundEffect;
+
+enum class AudioCue {
+    Present,      // Yoklamaya yeni eklendi
+    Duplicate,    // Zaten yoklamada / az önce okutuldu
+    Unknown,      // Sistemde olmayan kart
+    NotEnrolled   // Derse kayıtlı değil
+};
+
+struct AudioCueStats {
+    qint64 requested = 0;
+    qint64 started = 0;
+    qint64 restarted = 0;        // Tüm sesler çalarken en eskisi baştan başlatıldı
+    qint64 totalDecodeToStartMs = 0;
+    qint64 maxDecodeToStartMs = 0;
+
+    qint64 averageDecodeToStartMs() const { return started > 0 ? totalDecodeToStartMs / started : 0; }
+};
+
+// Kart okutma geri bildirimi için önceden yüklenmiş kısa sesler.
+// QMediaPlayer'ın aksine QSoundEffect PCM veriyi bellekte tutar ve düşük gecikmeyle başlar.
+// Her ipucu için birkaç ses kopyası vardır; art arda okutmalarda sesler üst üste çalabilir.
+// Dizinde ipucu dosyası yoksa kısa bir ton üretilip geçici dizine yazılır.
+class AudioCueBank : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kCueCount = 4;
+    static constexpr int kVoicesPerCue = 3;
+
+    explicit AudioCueBank(QObject* parent = nullptr);
+
+    // success.wav, duplicate.wav, unknown.wav, not_enrolled.wav
+    void load(const QString& directory);
+    void setVolume(qreal volume);
+
+    // detectedAtMs: UID'nin okuyucu thread'inde çözüldüğü an (epoch ms), gecikme ölçümü için
+    void play(AudioCue cue, qint64 detectedAtMs);
+
+    const AudioCueStats& stats() const { return m_stats; }
+
+private:
+    struct Voice {
+        QSoundEffect* effect = nullptr;
+        qint64 detectedAtMs = 0; // Başlaması beklenen çalma için, yoksa 0
+    };
+
+    static QString cueFileName(AudioCue cue);
+    static QString generateTone(AudioCue cue);
+    void onPlayingChanged(int cue, int voice);
+
+    QVector<Voice> m_voices[kCueCount];
+    int m_nextVoice[kCueCount];
+    AudioCueStats m_stats;
+};
+
+#endif // AUDIOCUEBANK_H
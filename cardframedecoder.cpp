@@ -0,0 +1,84 @@
+#include "cardframedecoder.h"
+
+CardFrameDecoder::CardFrameDecoder()
+    : m_head(0)
+    , m_count(0)
+{
+}
+
+int CardFrameDecoder::feed(const char* data, int size)
+{
+    int accepted = qMin(size, kCapacity - m_count);
+    int tail = (m_head + m_count) & (kCapacity - 1);
+    for (int i = 0; i < accepted; ++i) {
+        m_buffer[(tail + i) & (kCapacity - 1)] = data[i];
+    }
+    m_count += accepted;
+    return accepted;
+}
+
+bool CardFrameDecoder::nextFrame(QByteArray& frame)
+{
+    while (m_count > 0) {
+        if (at(0) != STX) {
+            discard(1);
+            m_stats.discardedBytes++;
+            continue;
+        }
+        if (m_count < 2) return false;
+
+        int length = at(1);
+        if (length < kMinFrameLength) {
+            // Bu STX bir çerçeve başı olamaz, sonraki baytta senkron ara
+            discard(1);
+            m_stats.framingErrors++;
+            m_stats.discardedBytes++;
+            continue;
+        }
+        if (m_count < length) return false; // Çerçevenin devamı bekleniyor
+
+        if (at(length - 1) != ETX) {
+            discard(1);
+            m_stats.framingErrors++;
+            m_stats.discardedBytes++;
+            continue;
+        }
+
+        for (int i = 0; i < length; ++i) {
+            m_frame[i] = static_cast<char>(at(i));
+        }
+        if (calculateLRC(m_frame, length - 2) != static_cast<quint8>(m_frame[length - 2])) {
+            discard(1);
+            m_stats.lrcErrors++;
+            m_stats.discardedBytes++;
+            continue;
+        }
+
+        discard(length);
+        m_stats.framesDecoded++;
+        frame = QByteArray::fromRawData(m_frame, length);
+        return true;
+    }
+    return false;
+}
+
+void CardFrameDecoder::reset()
+{
+    m_head = 0;
+    m_count = 0;
+}
+
+quint8 CardFrameDecoder::calculateLRC(const char* data, int size)
+{
+    quint8 lrc = 0;
+    for (int i = 0; i < size; ++i) {
+        lrc ^= static_cast<quint8>(data[i]);
+    }
+    return lrc;
+}
+
+void CardFrameDecoder::discard(int count)
+{
+    m_head = (m_head + count) & (kCapacity - 1);
+    m_count -= count;
+}
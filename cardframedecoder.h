@@ -0,0 +1,62 @@
+#ifndef CARDFRAMEDECODER_H
+#define CARDFRAMEDECODER_H
+
+#include <QByteArray>
+#include <QtGlobal>
+
+// Protokol sabitleri
+#define STX 0x02
+#define ETX 0x03
+#define PCB 0x00
+#define INS_DO 0x3E
+#define INS_SET 0x3C
+#define INS_GET 0x3D
+#define INS_NAK 0x15
+
+struct CardFrameDecoderStats {
+    qint64 framesDecoded = 0;
+    qint64 lrcErrors = 0;       // LRC tutmayan çerçeveler
+    qint64 framingErrors = 0;   // LEN'in gösterdiği yerde ETX olmayan veya geçersiz LEN
+    qint64 discardedBytes = 0;  // Senkron ararken atlanan baytlar
+};
+
+// Kart okuyucudan gelen bayt akışını çerçevelere ayıran artımlı çözücü.
+// Çerçeve: STX | LEN | PCB | INS | DATA... | LRC | ETX
+// LEN tüm çerçevenin uzunluğudur, LRC STX'ten itibaren LRC'ye kadar olan baytların XOR'udur.
+// Baytlar sabit boyutlu bir halka tamponda tutulur; hatalı çerçevede bir bayt kaydırılıp
+// bir sonraki STX aranır. Çözme sırasında bellek ayrılmaz.
+class CardFrameDecoder
+{
+public:
+    static constexpr int kCapacity = 512;        // 2'nin kuvveti, en uzun çerçevenin iki katı
+    static constexpr int kMaxFrameLength = 255;  // LEN tek bayt
+    static constexpr int kMinFrameLength = 6;    // STX, LEN, PCB, INS, LRC, ETX
+
+    CardFrameDecoder();
+
+    // Baytları tampona ekler, sığan bayt sayısını döner. Tampon dolduysa
+    // önce nextFrame ile çerçeveler alınmalı.
+    int feed(const char* data, int size);
+
+    // Tampondaki bir sonraki geçerli çerçeveyi (STX ve ETX dahil) verir.
+    // frame dahili tampona işaret eder ve bir sonraki nextFrame/feed çağrısına kadar geçerlidir.
+    bool nextFrame(QByteArray& frame);
+
+    void reset();
+    int bufferedBytes() const { return m_count; }
+    const CardFrameDecoderStats& stats() const { return m_stats; }
+
+    static quint8 calculateLRC(const char* data, int size);
+
+private:
+    quint8 at(int offset) const { return static_cast<quint8>(m_buffer[(m_head + offset) & (kCapacity - 1)]); }
+    void discard(int count);
+
+    char m_buffer[kCapacity];
+    char m_frame[kMaxFrameLength];
+    int m_head;
+    int m_count;
+    CardFrameDecoderStats m_stats;
+};
+
+#endif // CARDFRAMEDECODER_H
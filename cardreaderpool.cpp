@@ -0,0 +1,177 @@
+#include "cardreaderpool.h"
+#include <QThread>
+#include <QSettings>
+#include <QDebug>
+#include <algorithm>
+
+CardReaderPool::CardReaderPool(QObject* parent)
+    : QObject(parent)
+    , m_recentNext(0)
+    , m_polling(false)
+{
+}
+
+CardReaderPool::~CardReaderPool()
+{
+    close();
+}
+
+void CardReaderPool::openConfigured()
+{
+#ifdef Q_OS_WIN
+    const QString defaultPort = "COM10";
+#else
+    const QString defaultPort = "/dev/ttyUSB0";
+#endif
+    QSettings settings("yoklama_ayarlar.ini", QSettings::IniFormat);
+    settings.beginGroup("CardReaders");
+    // Virgülle ayrılmış liste, ör. ports=COM10,COM11 veya ports=/dev/ttyUSB0,/dev/ttyACM0
+    QStringList ports = settings.value("ports", defaultPort).toStringList();
+    int minPollMs = settings.value("minPollMs", 50).toInt();
+    int maxPollMs = settings.value("maxPollMs", 1000).toInt();
+    settings.endGroup();
+
+    open(ports, minPollMs, maxPollMs);
+}
+
+void CardReaderPool::open(const QStringList& portNames, int minPollMs, int maxPollMs)
+{
+    close();
+
+    for (const QString& portName : portNames) {
+        QString name = portName.trimmed();
+        if (name.isEmpty()) continue;
+
+        int index = m_readers.count();
+        Reader reader;
+        reader.thread = new QThread(this);
+        reader.worker = new CardReaderWorker(name, index);
+        reader.worker->moveToThread(reader.thread);
+        reader.stats.portName = name;
+
+        connect(reader.thread, &QThread::started, reader.worker, &CardReaderWorker::open);
+        connect(reader.thread, &QThread::finished, reader.worker, &QObject::deleteLater);
+        connect(reader.worker, &CardReaderWorker::uidsAvailable, this, &CardReaderPool::drainReaders);
+        connect(reader.worker, &CardReaderWorker::portStateChanged, this, [this, index](bool open, const QString& error) {
+            m_readers[index].stats.open = open;
+            // Port açılmadan önce başlamış bir yoklama varsa bu okuyucuda da başlat
+            if (open && m_polling) {
+                QMetaObject::invokeMethod(m_readers[index].worker, "startPolling", Qt::QueuedConnection);
+            }
+            emit readerStateChanged(index, open, error);
+        });
+        QMetaObject::invokeMethod(reader.worker, "setPollLimits", Qt::QueuedConnection,
+                                  Q_ARG(int, minPollMs), Q_ARG(int, maxPollMs));
+
+        m_readers.append(reader);
+        reader.thread->start();
+        qDebug() << "Kart okuyucu" << index << "başlatılıyor:" << name;
+    }
+}
+
+void CardReaderPool::close()
+{
+    if (m_readers.isEmpty()) return;
+    logStats();
+
+    for (const Reader& reader : m_readers) {
+        // Port okuyucu thread'inde kapatılır, sonra thread durdurulur
+        QMetaObject::invokeMethod(reader.worker, "close", Qt::BlockingQueuedConnection);
+        reader.thread->quit();
+        reader.thread->wait();
+        delete reader.thread;
+    }
+    m_readers.clear();
+    m_polling = false;
+}
+
+void CardReaderPool::startPolling()
+{
+    if (m_polling) return;
+    m_polling = true;
+    for (const Reader& reader : m_readers) {
+        if (reader.stats.open) {
+            QMetaObject::invokeMethod(reader.worker, "startPolling", Qt::QueuedConnection);
+        }
+    }
+}
+
+void CardReaderPool::stopPolling()
+{
+    if (!m_polling) return;
+    m_polling = false;
+    for (const Reader& reader : m_readers) {
+        QMetaObject::invokeMethod(reader.worker, "stopPolling", Qt::QueuedConnection);
+    }
+    logStats();
+}
+
+void CardReaderPool::pollOnce()
+{
+    for (const Reader& reader : m_readers) {
+        if (reader.stats.open) {
+            QMetaObject::invokeMethod(reader.worker, "pollOnce", Qt::QueuedConnection);
+        }
+    }
+}
+
+bool CardReaderPool::hasOpenReader() const
+{
+    for (const Reader& reader : m_readers) {
+        if (reader.stats.open) return true;
+    }
+    return false;
+}
+
+void CardReaderPool::drainReaders()
+{
+    // Yerel liste: cardTapped'e bağlı kod modal pencere açıp bu fonksiyona tekrar girebilir
+    QVector<CardUidEvent> events;
+    for (const Reader& reader : m_readers) {
+        reader.worker->rearmNotification();
+        CardUidEvent event;
+        while (reader.worker->takeUid(event)) {
+            events.append(event);
+        }
+    }
+    if (events.isEmpty()) return;
+
+    std::stable_sort(events.begin(), events.end(), [](const CardUidEvent& a, const CardUidEvent& b) {
+        return a.detectedAtMs < b.detectedAtMs;
+    });
+
+    for (const CardUidEvent& event : events) {
+        if (event.readerIndex < 0 || event.readerIndex >= m_readers.count()) continue;
+        CardReaderStats& stats = m_readers[event.readerIndex].stats;
+        if (isDuplicate(event)) {
+            stats.duplicates++;
+            continue;
+        }
+        stats.taps++;
+        emit cardTapped(event.uid, event.readerIndex, event.detectedAtMs);
+    }
+}
+
+bool CardReaderPool::isDuplicate(const CardUidEvent& event)
+{
+    // Son birkaç okuma doğrusal taranır; kapı sayısı ve giriş hızı için yeterli
+    for (const RecentTap& recent : m_recent) {
+        if (recent.uid == event.uid && event.detectedAtMs - recent.atMs < kDuplicateWindowMs) {
+            return true;
+        }
+    }
+    m_recent[m_recentNext] = {event.uid, event.detectedAtMs};
+    m_recentNext = (m_recentNext + 1) % kRecentTaps;
+    return false;
+}
+
+void CardReaderPool::logStats() const
+{
+    for (int i = 0; i < m_readers.count(); ++i) {
+        const Reader& reader = m_readers.at(i);
+        qDebug() << "Kart okuyucu" << i << reader.stats.portName
+                 << (reader.stats.open ? "açık" : "kapalı")
+                 << "| okuma:" << reader.stats.taps << "tekrar:" << reader.stats.duplicates
+                 << "kuyruk taşması:" << reader.worker->droppedUids();
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef CARDREADERPOOL_H
+#define CARDREADERPOOL_H
+
+#include <QObject>
+#include <QVector>
+#include <QStringList>
+#include "cardreaderworker.h"
+
+class QThread;
+
+struct CardReaderStats {
+    QString portName;
+    bool open = false;
+    qint64 taps = 0;        // Uygulamaya iletilen okumalar
+    qint64 duplicates = 0;  // Az önce başka kapıda okunduğu için atlananlar
+};
+
+// Birden fazla kart okuyucuyu (her biri kendi thread'i ve çözücüsüyle) yöneten havuz.
+// Okuyucuların kuyrukları GUI thread'inde boşaltılır, okumalar zaman sırasına
+// dizilir ve aynı kartın farklı okuyuculardan kısa aralıkla gelen tekrarları elenir.
+class CardReaderPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kDuplicateWindowMs = 1500;
+
+    explicit CardReaderPool(QObject* parent = nullptr);
+    ~CardReaderPool();
+
+    // Ayarlardaki portlar (CardReaders/ports) ve yoklama aralıkları ile açar
+    void openConfigured();
+    void open(const QStringList& portNames, int minPollMs, int maxPollMs);
+    void close();
+
+    void startPolling();
+    void stopPolling();
+    void pollOnce();
+
+    bool isPolling() const { return m_polling; }
+    bool hasOpenReader() const;
+    int readerCount() const { return m_readers.count(); }
+    const CardReaderStats& stats(int readerIndex) const { return m_readers.at(readerIndex).stats; }
+    void logStats() const;
+
+signals:
+    // Okumalar tespit zamanı sırasıyla yayınlanır; detectedAtMs UID'nin çözüldüğü an (epoch ms)
+    void cardTapped(const CardUid& uid, int readerIndex, qint64 detectedAtMs);
+    void readerStateChanged(int readerIndex, bool open, const QString& error);
+
+private slots:
+    void drainReaders();
+
+private:
+    bool isDuplicate(const CardUidEvent& event);
+
+    struct Reader {
+        QThread* thread;
+        CardReaderWorker* worker;
+        CardReaderStats stats;
+    };
+
+    struct RecentTap {
+        CardUid uid;
+        qint64 atMs = 0;
+    };
+    static constexpr int kRecentTaps = 16;
+
+    QVector<Reader> m_readers;
+    RecentTap m_recent[kRecentTaps];
+    int m_recentNext;
+    bool m_polling;
+};
+
+#endif // CARDREADERPOOL_H
@@ -0,0 +1,254 @@
+#include "cardreaderworker.h"
+#include <QSerialPort>
+#include <QTimer>
+#include <QDateTime>
+#include <QDebug>
+
+CardReaderWorker::CardReaderWorker(const QString& portName, int readerIndex, QObject* parent)
+    : QObject(parent)
+    , m_portName(portName)
+    , m_readerIndex(readerIndex)
+    , m_port(nullptr)
+    , m_pollTimer(nullptr)
+    , m_polling(false)
+    , m_awaitingResponse(false)
+    , m_notifyPending(false)
+    , m_droppedUids(0)
+{
+}
+
+void CardReaderWorker::open()
+{
+    // Port ve timer bu thread'de oluşturulur ki sinyalleri burada işlensin
+    if (!m_port) {
+        m_port = new QSerialPort(this);
+        m_pollTimer = new QTimer(this);
+        m_pollTimer->setSingleShot(true);
+        connect(m_port, &QSerialPort::readyRead, this, &CardReaderWorker::onReadyRead);
+        connect(m_pollTimer, &QTimer::timeout, this, &CardReaderWorker::onPollTimer);
+    }
+    if (m_port->isOpen()) return;
+
+    m_port->setPortName(m_portName);
+    m_port->setBaudRate(QSerialPort::Baud115200);
+    m_port->setDataBits(QSerialPort::Data8);
+    m_port->setParity(QSerialPort::NoParity);
+    m_port->setStopBits(QSerialPort::OneStop);
+    m_port->setFlowControl(QSerialPort::NoFlowControl);
+
+    if (m_port->open(QIODevice::ReadWrite)) {
+        qDebug() << "Seri port" << m_portName << "açıldı (okuyucu thread'i)";
+        m_decoder.reset();
+        emit portStateChanged(true, QString());
+    } else {
+        qDebug() << "Seri port açılamadı:" << m_port->errorString();
+        emit portStateChanged(false, m_port->errorString());
+    }
+}
+
+void CardReaderWorker::close()
+{
+    if (!m_port) return;
+    stopPolling();
+    if (m_port->isOpen()) {
+        m_port->close();
+        emit portStateChanged(false, QString());
+    }
+}
+
+void CardReaderWorker::setPollLimits(int minIntervalMs, int maxIntervalMs)
+{
+    m_scheduler.setLimits(minIntervalMs, maxIntervalMs);
+    qDebug() << "Kart yoklama aralığı:" << m_scheduler.minIntervalMs() << "-" << m_scheduler.maxIntervalMs() << "ms";
+}
+
+void CardReaderWorker::startPolling()
+{
+    if (!m_port || !m_port->isOpen() || m_polling) return;
+    m_polling = true;
+    m_scheduler.reset();
+    sendPoll();
+    qDebug() << "Kart okuyucu periyodik yoklama başlatıldı.";
+}
+
+void CardReaderWorker::stopPolling()
+{
+    if (!m_polling) return;
+    m_polling = false;
+    m_awaitingResponse = false;
+    // Yoklama yeniden başladığında okuyucudaki kart yeni bir okuma sayılır
+    m_cardOnReader = CardUid();
+    m_pollTimer->stop();
+    logPollStats();
+    qDebug() << "Kart okuyucu periyodik yoklama durduruldu.";
+}
+
+void CardReaderWorker::pollOnce()
+{
+    // Tek seferlik okuma; periyodik yoklama açıksa zaten sırada bir komut var
+    if (m_polling) return;
+    sendPoll();
+}
+
+void CardReaderWorker::onPollTimer()
+{
+    if (m_awaitingResponse) {
+        // Okuyucu zamanında yanıt vermedi
+        m_awaitingResponse = false;
+        // Kartın hâlâ okuyucuda olduğu bilinmiyor; aynı kart tekrar gelirse
+        // mükerrer okumayı arayüzdeki son okumalar önbelleği eler
+        m_cardOnReader = CardUid();
+        m_scheduler.recordTimeout();
+        if (m_polling) {
+            m_pollTimer->start(m_scheduler.nextIntervalMs());
+        }
+        return;
+    }
+    if (m_polling) {
+        sendPoll();
+    }
+}
+
+void CardReaderWorker::sendPoll()
+{
+    if (!m_port || !m_port->isOpen()) {
+        qDebug() << "Poll denemesi: Port kapalı.";
+        return;
+    }
+    m_port->write(createPollPacket());
+    m_scheduler.recordPollSent();
+    m_pollClock.start();
+    m_awaitingResponse = true;
+    m_pollTimer->start(kResponseTimeoutMs);
+}
+
+void CardReaderWorker::handleResponse(bool newCard)
+{
+    if (!m_awaitingResponse) return; // Zaman aşımından sonra gelen yanıt
+    m_awaitingResponse = false;
+
+    if (newCard) {
+        m_scheduler.recordCard(m_pollClock.nsecsElapsed() / 1000);
+        if (m_scheduler.stats().cards % 20 == 0) {
+            logPollStats();
+        }
+    } else {
+        m_scheduler.recordEmpty();
+    }
+
+    if (m_polling) {
+        m_pollTimer->start(m_scheduler.nextIntervalMs());
+    } else {
+        m_pollTimer->stop();
+    }
+}
+
+void CardReaderWorker::logPollStats() const
+{
+    const PollSchedulerStats& stats = m_scheduler.stats();
+    qDebug() << "Kart yoklama istatistikleri - yoklama:" << stats.polls << "kart:" << stats.cards
+             << "kart başına yoklama:" << stats.pollsPerCard()
+             << "| yoklama-UID gecikmesi ort:" << stats.averageLatencyUs() << "µs en fazla:" << stats.maxLatencyUs << "µs"
+             << "| boş yanıt:" << stats.emptyResponses << "zaman aşımı:" << stats.timeouts
+             << "| sıradaki aralık:" << m_scheduler.nextIntervalMs() << "ms";
+}
+
+void CardReaderWorker::onReadyRead()
+{
+    QByteArray data = m_port->readAll();
+    const char* bytes = data.constData();
+    int remaining = data.size();
+
+    // Bir okumada birden fazla çerçeve, yarım çerçeve ya da çöp bayt gelebilir
+    while (remaining > 0) {
+        int accepted = m_decoder.feed(bytes, remaining);
+        bytes += accepted;
+        remaining -= accepted;
+
+        QByteArray frame;
+        while (m_decoder.nextFrame(frame)) {
+            CardUid uid = extractUid(frame);
+            // Kart okuyucunun üzerinde durdukça her yoklamada aynı UID gelir;
+            // kart kaldırılıp boş yanıt alınana kadar tekrar yayınlanmaz
+            bool newCard = false;
+            if (!uid.isValid()) {
+                m_cardOnReader = CardUid();
+            } else if (uid != m_cardOnReader) {
+                m_cardOnReader = uid;
+                publishUid(uid);
+                newCard = true;
+            }
+            // Okuyucuda duran kartın tekrarı boş yanıt sayılır; yoklama aralığı geri çekilir
+            // ve istatistiklerde yeni kart olarak görünmez
+            handleResponse(newCard);
+        }
+    }
+}
+
+void CardReaderWorker::publishUid(const CardUid& uid)
+{
+    if (!m_queue.push({uid, QDateTime::currentMSecsSinceEpoch(), m_readerIndex})) {
+        m_droppedUids.fetch_add(1, std::memory_order_relaxed);
+        qWarning() << "Kart kuyruğu dolu, UID atlandı:" << uid;
+        return;
+    }
+    // Tüketici kuyruğu boşaltana kadar tek bir bildirim yeterli
+    if (!m_notifyPending.exchange(true, std::memory_order_acq_rel)) {
+        emit uidsAvailable();
+    }
+}
+
+void CardReaderWorker::rearmNotification()
+{
+    m_notifyPending.store(false, std::memory_order_release);
+}
+
+bool CardReaderWorker::takeUid(CardUidEvent& event)
+{
+    return m_queue.pop(event);
+}
+
+QByteArray CardReaderWorker::createPollPacket()
+{
+    // Çalışan komut: 02 0A 00 3E DF 7E 01 00 96 03
+    // STX | LEN | PCB | INS | DATA... | LRC | ETX
+    // LEN tüm paketin uzunluğu, LRC STX dahil önceki baytların XOR'u
+    QByteArray data;
+    data.append(static_cast<char>(0xDF));
+    data.append(static_cast<char>(0x7E));
+    data.append(static_cast<char>(0x01));
+    data.append(static_cast<char>(0x00));
+
+    QByteArray packet;
+    packet.append(static_cast<char>(STX));
+    quint8 totalLength = 1 + 1 + 1 + 1 + data.length() + 1 + 1; // STX+LEN+PCB+INS+DATA+LRC+ETX
+    packet.append(static_cast<char>(totalLength));
+    packet.append(static_cast<char>(PCB));
+    packet.append(static_cast<char>(INS_DO));
+    packet.append(data);
+    packet.append(static_cast<char>(CardFrameDecoder::calculateLRC(packet.constData(), packet.size())));
+    packet.append(static_cast<char>(ETX));
+    return packet;
+}
+
+CardUid CardReaderWorker::extractUid(const QByteArray& frame)
+{
+    // UID etiketi: DF 0D | uzunluk | UID baytları
+    static const QByteArray uidTag("\xDF\x0D", 2);
+
+    int tagIndex = frame.indexOf(uidTag);
+    if (tagIndex == -1) {
+        return CardUid();
+    }
+    int uidLengthIndex = tagIndex + uidTag.length();
+    if (frame.length() <= uidLengthIndex) {
+        return CardUid();
+    }
+    int uidLength = static_cast<quint8>(frame.at(uidLengthIndex));
+    int uidStartIndex = uidLengthIndex + 1;
+    if (frame.length() < uidStartIndex + uidLength) {
+        return CardUid();
+    }
+    // Baytlar doğrudan sabit boyutlu anahtara kopyalanır, metin üretilmez
+    return CardUid::fromBytes(frame.constData() + uidStartIndex, uidLength);
+}
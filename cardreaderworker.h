@@ -0,0 +1,85 @@
+#ifndef CARDREADERWORKER_H
+#define CARDREADERWORKER_H
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <atomic>
+#include "carduid.h"
+#include "cardframedecoder.h"
+#include "pollscheduler.h"
+#include "spscqueue.h"
+
+class QSerialPort;
+class QTimer;
+
+// Okuyucudan çözülen kart UID'si
+struct CardUidEvent {
+    CardUid uid;
+    qint64 detectedAtMs;  // QDateTime::currentMSecsSinceEpoch
+    int readerIndex;
+};
+
+// Kart okuyucu portunu, uyarlamalı yoklamayı (PollScheduler) ve çerçeve çözmeyi kendi thread'inde yürüten sınıf.
+// moveToThread ile ayrı bir QThread'e taşınır; slotlar o thread'de çalışır.
+// Çözülen UID'ler kilitsiz kuyruğa yazılır ve GUI thread'i uidsAvailable ile uyarılır,
+// böylece GUI thread'i meşgulken (modal pencere, tablo yükleme) okumalar kaybolmaz.
+class CardReaderWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kQueueCapacity = 256;
+    static constexpr int kResponseTimeoutMs = 300;  // Yanıt gelmezse boş yanıt sayılır
+
+    CardReaderWorker(const QString& portName, int readerIndex, QObject* parent = nullptr);
+
+    // Tüketici (GUI) thread'i: uidsAvailable geldiğinde önce rearmNotification,
+    // sonra takeUid false dönene kadar kuyruğu boşaltır
+    void rearmNotification();
+    bool takeUid(CardUidEvent& event);
+    qint64 droppedUids() const { return m_droppedUids.load(std::memory_order_relaxed); }
+
+    static QByteArray createPollPacket();
+    static CardUid extractUid(const QByteArray& frame);
+
+public slots:
+    void open();
+    void close();
+    void setPollLimits(int minIntervalMs, int maxIntervalMs);
+    void startPolling();
+    void stopPolling();
+    void pollOnce();
+
+signals:
+    void portStateChanged(bool open, const QString& error);
+    void uidsAvailable();
+
+private slots:
+    void onReadyRead();
+    void onPollTimer();
+
+private:
+    void sendPoll();
+    void handleResponse(bool newCard);
+    void logPollStats() const;
+    void publishUid(const CardUid& uid);
+
+    QString m_portName;
+    int m_readerIndex;
+    QSerialPort* m_port;
+    QTimer* m_pollTimer;
+    CardFrameDecoder m_decoder;
+    PollScheduler m_scheduler;
+    QElapsedTimer m_pollClock;
+    bool m_polling;
+    bool m_awaitingResponse;
+    CardUid m_cardOnReader;
+
+    SpscQueue<CardUidEvent, kQueueCapacity> m_queue;
+    std::atomic<bool> m_notifyPending;
+    std::atomic<qint64> m_droppedUids;
+};
+
+#endif // CARDREADERWORKER_H
@@ -0,0 +1,53 @@
+#include "carduid.h"
+
+CardUid CardUid::fromBytes(const char* data, int length)
+{
+    CardUid uid;
+    if (length <= 0 || length > kMaxLength) {
+        return uid;
+    }
+    std::memcpy(uid.m_bytes, data, length);
+    uid.m_length = static_cast<quint8>(length);
+    return uid;
+}
+
+CardUid CardUid::fromString(const QString& text)
+{
+    CardUid uid;
+    int high = -1;
+    for (QChar ch : text) {
+        // Ayraçlar atlanır
+        if (ch == ' ' || ch == ':' || ch == '-') continue;
+
+        char c = ch.toLatin1();
+        int nibble;
+        if (c >= '0' && c <= '9') {
+            nibble = c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            nibble = c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            nibble = c - 'A' + 10;
+        } else {
+            return CardUid();
+        }
+        if (high < 0) {
+            high = nibble;
+            continue;
+        }
+        if (uid.m_length == kMaxLength) {
+            return CardUid();
+        }
+        uid.m_bytes[uid.m_length++] = static_cast<quint8>((high << 4) | nibble);
+        high = -1;
+    }
+    // Tek sayıda hex karakter
+    if (high >= 0) {
+        return CardUid();
+    }
+    return uid;
+}
+
+QString CardUid::toString() const
+{
+    return QString::fromLatin1(toByteArray().toHex(' ').toUpper());
+}
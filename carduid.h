@@ -0,0 +1,55 @@
+#ifndef CARDUID_H
+#define CARDUID_H
+
+#include <QByteArray>
+#include <QString>
+#include <QHashFunctions>
+#include <QDebug>
+#include <cstring>
+
+// Kart UID'si için sabit boyutlu anahtar.
+// Okuyucudan veritabanına kadar ham baytlar taşınır (students.cardUID BLOB);
+// "04 A1 B2 C3" biçimindeki metin sadece arayüzde üretilir.
+class CardUid
+{
+public:
+    static constexpr int kMaxLength = 10; // ISO 14443: 4, 7 veya 10 bayt
+
+    CardUid() : m_length(0) { std::memset(m_bytes, 0, sizeof(m_bytes)); }
+
+    // Uzunluk 0 veya kMaxLength'ten büyükse geçersiz UID döner
+    static CardUid fromBytes(const char* data, int length);
+    static CardUid fromByteArray(const QByteArray& bytes) { return fromBytes(bytes.constData(), bytes.size()); }
+    // "04 A1 B2 C3", "04a1b2c3" veya "04:A1:B2:C3"; hatalıysa geçersiz UID döner
+    static CardUid fromString(const QString& text);
+
+    bool isValid() const { return m_length > 0; }
+    int length() const { return m_length; }
+
+    // Veritabanına bağlanacak değer (BLOB)
+    const quint8* constData() const { return m_bytes; }
+    QByteArray toByteArray() const { return QByteArray(reinterpret_cast<const char*>(m_bytes), m_length); }
+    QString toString() const;
+
+    bool operator==(const CardUid& other) const
+    {
+        return m_length == other.m_length && std::memcmp(m_bytes, other.m_bytes, sizeof(m_bytes)) == 0;
+    }
+    bool operator!=(const CardUid& other) const { return !(*this == other); }
+
+    friend size_t qHash(const CardUid& uid, size_t seed = 0)
+    {
+        return qHashBits(uid.m_bytes, uid.m_length, seed);
+    }
+
+private:
+    quint8 m_bytes[kMaxLength]; // Kullanılmayan baytlar sıfır, karşılaştırma sabit boyutlu
+    quint8 m_length;
+};
+
+inline QDebug operator<<(QDebug debug, const CardUid& uid)
+{
+    return debug << uid.toString();
+}
+
+#endif // CARDUID_H
@@ -1,6 +1,200 @@
 #include "databasemanager.h"
 #include <QDebug>
 #include <QDateTime>
+#include <QThread>
+#include <QThreadStorage>
+#include <limits>
+
+namespace {
+
+// Sık çalışan sorgular (sorgu planı kontrolünde de kullanılır)
+const char* const kSqlStudentsForCourse =
+    "SELECT s.id, s.studentNumber, s.firstName, s.lastName, s.cardUID FROM students s "
+    "JOIN enrollments e ON s.id = e.studentId WHERE e.courseId = :courseId "
+    "ORDER BY s.lastName, s.firstName";
+
+const char* const kSqlStudentByCardUID =
+    "SELECT id, studentNumber, firstName, lastName, cardUID FROM students WHERE cardUID = :cardUID";
+
+const char* const kSqlTapLookup =
+    "SELECT s.id, s.studentNumber, s.firstName, s.lastName, s.cardUID, "
+    "e.id IS NOT NULL AS enrolled, r.id IS NOT NULL AS present "
+    "FROM students s "
+    "LEFT JOIN attendance_sessions a ON a.id = :sessionId "
+    "LEFT JOIN enrollments e ON e.studentId = s.id AND e.courseId = a.course_id "
+    "LEFT JOIN attendanceRecords r ON r.studentId = s.id AND r.sessionId = a.id "
+    "WHERE s.cardUID = :cardUID";
+
+const char* const kSqlSessionRoster =
+    "SELECT s.id, s.studentNumber, s.firstName, s.lastName, s.cardUID, r.time "
+    "FROM attendance_sessions a "
+    "JOIN enrollments e ON e.courseId = a.course_id "
+    "JOIN students s ON s.id = e.studentId "
+    "LEFT JOIN attendanceRecords r ON r.studentId = s.id AND r.sessionId = a.id "
+    "WHERE a.id = :sessionId";
+
+const char* const kSqlCourseRosterStatus =
+    "SELECT s.id, s.studentNumber, s.firstName, s.lastName, s.cardUID, r.time "
+    "FROM enrollments e "
+    "JOIN students s ON s.id = e.studentId "
+    "LEFT JOIN attendanceRecords r ON r.studentId = s.id AND r.sessionId = :sessionId "
+    "WHERE e.courseId = :courseId "
+    "ORDER BY s.lastName, s.firstName";
+
+const char* const kSqlAttendanceForSession =
+    "SELECT s.studentNumber, s.firstName, s.lastName, r.time FROM students s "
+    "JOIN attendanceRecords r ON s.id = r.studentId "
+    "WHERE r.sessionId = :sessionId ORDER BY r.time DESC";
+
+// Sayfalı listeler (start_time, id) imlecinden sonrasını getirir. id rowid olduğu için
+// (teacher_id, start_time) / (course_id, start_time) / (start_time) indeksleri id ile biter;
+// sayfa ne kadar derinde olursa olsun indeksten imlecin yerine atlanır, OFFSET gibi satır atlanmaz.
+const char* const kSqlTeacherHistoryPage =
+    "SELECT s.id, s.title, s.start_time, s.end_time, s.is_active, c.course_name, c.course_code, "
+    "s.attendee_count as student_count "
+    "FROM attendance_sessions s "
+    "JOIN courses c ON s.course_id = c.id "
+    "WHERE s.teacher_id = :teacherId AND (s.start_time, s.id) < (:afterStart, :afterId) "
+    "ORDER BY s.start_time DESC, s.id DESC LIMIT :limit";
+
+const char* const kSqlCourseSessionsPage =
+    "SELECT s.id, s.title, s.start_time, s.end_time, s.is_active, c.course_name, c.course_code, "
+    "s.attendee_count as student_count "
+    "FROM attendance_sessions s "
+    "JOIN courses c ON s.course_id = c.id "
+    "WHERE s.course_id = :courseId AND (s.start_time, s.id) < (:afterStart, :afterId) "
+    "ORDER BY s.start_time DESC, s.id DESC LIMIT :limit";
+
+const char* const kSqlActiveSession =
+    "SELECT id FROM attendance_sessions WHERE teacher_id = ? AND is_active = 1";
+
+const char* const kSqlPendingDeleteRequests =
+    "SELECT r.id, r.sessionId, r.requestedAt, r.reason, r.status, "
+    "s.title as sessionTitle, u.fullName as teacherName "
+    "FROM attendanceDeleteRequests r "
+    "JOIN attendance_sessions s ON r.sessionId = s.id "
+    "JOIN users u ON r.requestedBy = u.id "
+    "WHERE r.status = 'pending' "
+    "ORDER BY r.requestedAt DESC";
+
+const char* const kSqlAdminOverviewPage =
+    "SELECT s.id, s.title, s.start_time, s.is_active, "
+    "c.course_name, u.fullName as teacherName, "
+    "s.attendee_count as studentCount "
+    "FROM attendance_sessions s "
+    "JOIN courses c ON s.course_id = c.id "
+    "JOIN users u ON s.teacher_id = u.id "
+    "WHERE (s.start_time, s.id) < (:afterStart, :afterId) "
+    "ORDER BY s.start_time DESC, s.id DESC LIMIT :limit";
+
+const char* const kSqlAttendanceDetails =
+    "SELECT s.studentNumber, s.firstName, s.lastName, "
+    "CASE WHEN ar.id IS NOT NULL THEN 'present' ELSE 'absent' END as status "
+    "FROM students s "
+    "JOIN enrollments e ON s.id = e.studentId "
+    "LEFT JOIN attendanceRecords ar ON s.id = ar.studentId AND ar.sessionId = :sessionId "
+    "WHERE e.courseId = :courseId "
+    "ORDER BY s.lastName, s.firstName";
+
+const char* const kSqlCoursesForStudent =
+    "SELECT c.id, c.course_name, c.course_code, c.teacher_id, c.created_by, c.created_at "
+    "FROM courses c "
+    "JOIN enrollments e ON c.id = e.courseId "
+    "WHERE e.studentId = :studentId";
+
+const char* const kSqlStudentAttendanceForCourse =
+    "SELECT s.id, s.title, s.start_time, c.course_name, r.time "
+    "FROM attendance_sessions s "
+    "JOIN courses c ON s.course_id = c.id "
+    "LEFT JOIN attendanceRecords r ON r.sessionId = s.id AND r.studentId = :studentId "
+    "WHERE s.course_id = :courseId "
+    "ORDER BY s.start_time DESC";
+
+const char* const kMainConnectionName = "yoklama_connection";
+const int kQueryThreadCount = 2;
+const int kWorkerBusyTimeoutMs = 5000;
+
+// Sorgu thread'ine özel bağlantı; thread bitince QThreadStorage siler ve bağlantı kaldırılır
+struct WorkerConnection {
+    QString name;
+    QString path;
+
+    ~WorkerConnection()
+    {
+        QSqlDatabase::database(name, false).close();
+        QSqlDatabase::removeDatabase(name);
+    }
+};
+
+QThreadStorage<WorkerConnection*> workerConnection;
+
+// İlk sayfa: tüm oturumlardan sonra gelen imleç; ilk ve sonraki sayfalar aynı sorguyu kullanır
+const char* const kFirstPageStartTime = "9999-12-31 23:59:59";
+
+AttendanceSession readAttendanceSession(const QSqlQuery& query)
+{
+    AttendanceSession session;
+    session.id = query.value("id").toInt();
+    session.title = query.value("title").toString();
+    QDateTime utcStart = QDateTime::fromString(query.value("start_time").toString(), "yyyy-MM-dd HH:mm:ss");
+    utcStart.setTimeSpec(Qt::UTC);
+    session.startTime = utcStart.toLocalTime();
+    QDateTime utcEnd = QDateTime::fromString(query.value("end_time").toString(), "yyyy-MM-dd HH:mm:ss");
+    utcEnd.setTimeSpec(Qt::UTC);
+    session.endTime = utcEnd.toLocalTime();
+    session.isActive = query.value("is_active").toBool();
+    session.courseName = query.value("course_name").toString();
+    session.courseCode = query.value("course_code").toString();
+    session.studentCount = query.value("student_count").toInt();
+    return session;
+}
+
+AdminAttendanceOverview readAdminOverview(const QSqlQuery& query)
+{
+    AdminAttendanceOverview item;
+    item.sessionId = query.value("id").toInt();
+    item.sessionTitle = query.value("title").toString();
+    item.teacherName = query.value("teacherName").toString();
+    item.courseName = query.value("course_name").toString();
+    QDateTime utc = QDateTime::fromString(query.value("start_time").toString(), "yyyy-MM-dd HH:mm:ss");
+    utc.setTimeSpec(Qt::UTC);
+    QDateTime local = utc.toLocalTime();
+    item.date = local.toString("dd.MM.yyyy");
+    item.startTime = local.toString("HH:mm");
+    item.status = query.value("is_active").toBool() ? "active" : "completed";
+    item.studentCount = query.value("studentCount").toInt();
+    return item;
+}
+
+// Hazırlanmış sayfa sorgusunu imleç ve limitle çalıştırır. Sonraki sayfa olup olmadığını
+// anlamak için bir fazla satır istenir; imleç son satırın ham start_time ve id değeridir.
+template<typename T, typename ReadRow>
+SessionPage<T> execSessionPage(QSqlQuery& query, const SessionPageCursor& after, int limit, ReadRow readRow)
+{
+    SessionPage<T> page;
+    query.bindValue(":afterStart", after.isStart() ? QString(kFirstPageStartTime) : after.startTime);
+    query.bindValue(":afterId", after.isStart() ? std::numeric_limits<int>::max() : after.id);
+    query.bindValue(":limit", limit + 1);
+
+    if (!query.exec()) {
+        qDebug() << "Oturum sayfası alınamadı:" << query.lastError().text();
+        return page;
+    }
+
+    page.rows.reserve(limit);
+    while (query.next()) {
+        if (page.rows.count() == limit) {
+            page.hasMore = true;
+            break;
+        }
+        page.rows.append(readRow(query));
+        page.next.startTime = query.value("start_time").toString();
+        page.next.id = query.value("id").toInt();
+    }
+    return page;
+}
+
+} // namespace
 
 DatabaseManager& DatabaseManager::instance()
 {
@@ -11,10 +205,13 @@ DatabaseManager& DatabaseManager::instance()
 DatabaseManager::DatabaseManager()
 {
     // Singleton, constructor'ı özel
+    // SQLite tek yazıcıya izin verir; okumalar için küçük bir havuz yeterli
+    m_queryPool.setMaxThreadCount(kQueryThreadCount);
 }
 
 DatabaseManager::~DatabaseManager()
 {
+    m_queryPool.waitForDone();
     if (m_db.isOpen()) {
         m_db.close();
     }
@@ -23,9 +220,9 @@ DatabaseManager::~DatabaseManager()
 bool DatabaseManager::openDatabase(const QString &path)
 {
     // Birden fazla bağlantı oluşmasını önlemek için bağlantı adı belirtiyoruz.
-    m_db = QSqlDatabase::database("yoklama_connection", false);
+    m_db = QSqlDatabase::database(kMainConnectionName, false);
     if (!m_db.isValid()) {
-        m_db = QSqlDatabase::addDatabase("QSQLITE", "yoklama_connection");
+        m_db = QSqlDatabase::addDatabase("QSQLITE", kMainConnectionName);
         m_db.setDatabaseName(path);
     }
 
@@ -34,19 +231,81 @@ bool DatabaseManager::openDatabase(const QString &path)
         return false;
     }
     qDebug() << "Veritabanına başarıyla bağlanıldı.";
+
+    // WAL: havuzdaki salt okunur bağlantıların raporları arayüzün ve yoklama yazıcısının
+    // yazmalarını bekletmez, yazma da okumaları bekletmez. Ayar veritabanı dosyasında kalıcıdır.
+    QSqlQuery walQuery(m_db);
+    if (!walQuery.exec("PRAGMA journal_mode=WAL") || !walQuery.next()
+        || walQuery.value(0).toString().compare("wal", Qt::CaseInsensitive) != 0) {
+        qDebug() << "WAL moduna geçilemedi, okumalar yazmaları bekletebilir:" << walQuery.lastError().text();
+    }
+
+    m_ownerThread = QThread::currentThread();
+    m_dbPath = m_db.databaseName();
+    m_tapQueriesPrepared = false;
     return true;
 }
 
 void DatabaseManager::closeDatabase()
 {
+    // Arka plan sorguları ana bağlantı kapanmadan biter
+    waitForQueries();
+
+    // Hazır sorgular bağlantıyı tuttuğu için önce onları bırak
+    m_tapLookupQuery = QSqlQuery();
+    m_tapInsertQuery = QSqlQuery();
+    m_tapQueriesPrepared = false;
+
     if (m_db.isOpen()) {
-        m_db.removeDatabase("yoklama_connection");
+        m_db.removeDatabase(kMainConnectionName);
     }
 }
 
+QString DatabaseManager::databasePath() const
+{
+    return m_db.databaseName();
+}
+
+QSqlDatabase DatabaseManager::connection() const
+{
+    if (QThread::currentThread() == m_ownerThread) {
+        return m_db;
+    }
+
+    // Ana bağlantı açıkken değişmez; arka plan sorguları açılıştan sonra başlar.
+    // m_db başka thread'e ait olduğu için yol açılışta saklanan kopyadan okunur.
+    QString path = m_dbPath;
+    WorkerConnection* worker = workerConnection.localData();
+    if (worker && worker->path != path) {
+        workerConnection.setLocalData(nullptr); // Eski dosyanın bağlantısı silinir
+        worker = nullptr;
+    }
+
+    if (!worker) {
+        worker = new WorkerConnection{
+            QString("%1_%2").arg(kMainConnectionName).arg(quintptr(QThread::currentThreadId())), path};
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", worker->name);
+        db.setDatabaseName(path);
+        // Yoklama yazıcısı commit ederken okuma hemen "database is locked" vermesin, beklesin
+        db.setConnectOptions(QString("QSQLITE_BUSY_TIMEOUT=%1;QSQLITE_OPEN_READONLY").arg(kWorkerBusyTimeoutMs));
+        if (!db.open()) {
+            qDebug() << "Sorgu thread'i veritabanını açamadı:" << db.lastError().text();
+        }
+        workerConnection.setLocalData(worker);
+        return db;
+    }
+    return QSqlDatabase::database(worker->name);
+}
+
+void DatabaseManager::waitForQueries()
+{
+    // waitForDone thread'leri de sonlandırır, thread'e özel bağlantılar böylece kaldırılır
+    m_queryPool.waitForDone();
+}
+
 QVariant DatabaseManager::authenticateUser(const QString& username, const QString& password, User& user)
 {
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     query.prepare("SELECT id, role, fullName FROM users WHERE username = :username AND password = :password");
     query.bindValue(":username", username);
     query.bindValue(":password", password);
@@ -67,7 +326,7 @@ QVariant DatabaseManager::authenticateUser(const QString& username, const QStrin
 QVector<Course> DatabaseManager::getCoursesForTeacher(int teacherId)
 {
     QVector<Course> courses;
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     query.prepare("SELECT id, course_name, course_code, teacher_id, created_by, created_at FROM courses WHERE teacher_id = :teacherId");
     query.bindValue(":teacherId", teacherId);
     if (query.exec()) {
@@ -88,15 +347,13 @@ QVector<Course> DatabaseManager::getCoursesForTeacher(int teacherId)
 QVector<Student> DatabaseManager::getStudentsForCourse(int courseId)
 {
     QVector<Student> students;
-    QSqlQuery query(m_db);
-    query.prepare("SELECT s.id, s.studentNumber, s.firstName, s.lastName, s.cardUID FROM students s "
-                  "JOIN enrollments e ON s.id = e.studentId WHERE e.courseId = :courseId "
-                  "ORDER BY s.lastName, s.firstName");
+    QSqlQuery query(connection());
+    query.prepare(kSqlStudentsForCourse);
     query.bindValue(":courseId", courseId);
     
     if (query.exec()) {
         while(query.next()) {
-            students.append({query.value(0).toInt(), query.value(1).toString(), query.value(2).toString(), query.value(3).toString(), query.value(4).toString()});
+            students.append({query.value(0).toInt(), query.value(1).toString(), query.value(2).toString(), query.value(3).toString(), CardUid::fromByteArray(query.value(4).toByteArray())});
         }
     }
     return students;
@@ -104,7 +361,7 @@ QVector<Student> DatabaseManager::getStudentsForCourse(int courseId)
 
 bool DatabaseManager::startAttendanceSession(int teacherId, int courseId, const QString& title)
 {
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     
     // SQL sorgusunu debug et
     QString sqlQuery = "INSERT INTO attendance_sessions (teacher_id, course_id, title, start_time, is_active) VALUES (?, ?, ?, datetime('now'), 1)";
@@ -127,7 +384,7 @@ bool DatabaseManager::startAttendanceSession(int teacherId, int courseId, const
 
 bool DatabaseManager::endAttendanceSession(int sessionId)
 {
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     query.prepare("UPDATE attendance_sessions SET end_time = datetime('now'), is_active = 0 "
                   "WHERE id = ?");
     query.addBindValue(sessionId);
@@ -141,30 +398,30 @@ bool DatabaseManager::endAttendanceSession(int sessionId)
     }
 }
 
-Student DatabaseManager::getStudentByCardUID(const QString& cardUID)
+Student DatabaseManager::getStudentByCardUID(const CardUid& cardUID)
 {
-    QSqlQuery query(m_db);
-    query.prepare("SELECT id, studentNumber, firstName, lastName, cardUID FROM students WHERE cardUID = :cardUID");
-    query.bindValue(":cardUID", cardUID);
+    QSqlQuery query(connection());
+    query.prepare(kSqlStudentByCardUID);
+    query.bindValue(":cardUID", cardUID.toByteArray());
     if(query.exec() && query.next()) {
-        return {query.value("id").toInt(), query.value("studentNumber").toString(), query.value("firstName").toString(), query.value("lastName").toString(), query.value("cardUID").toString()};
+        return {query.value("id").toInt(), query.value("studentNumber").toString(), query.value("firstName").toString(), query.value("lastName").toString(), CardUid::fromByteArray(query.value("cardUID").toByteArray())};
     }
     return Student(); // id = -1 olan boş öğrenci döner
 }
 
-bool DatabaseManager::isStudentEnrolled(const QString &cardUid, int courseId)
+bool DatabaseManager::isStudentEnrolled(const CardUid& cardUID, int courseId)
 {
     if (!m_db.isOpen()) {
         qCritical() << "Veritabanı kapalı!";
         return false; 
     }
 
-    QSqlQuery query;
+    QSqlQuery query(connection());
     query.prepare("SELECT 1 FROM enrollments e "
-                  "JOIN students s ON e.student_id = s.id "
-                  "WHERE s.card_uid = :card_uid AND e.course_id = :course_id");
-    query.bindValue(":card_uid", cardUid);
-    query.bindValue(":course_id", courseId);
+                  "JOIN students s ON e.studentId = s.id "
+                  "WHERE s.cardUID = :cardUID AND e.courseId = :courseId");
+    query.bindValue(":cardUID", cardUID.toByteArray());
+    query.bindValue(":courseId", courseId);
 
     if (!query.exec()) {
         qCritical() << "isStudentEnrolled sorgusu başarısız:" << query.lastError().text();
@@ -176,7 +433,7 @@ bool DatabaseManager::isStudentEnrolled(const QString &cardUid, int courseId)
 
 bool DatabaseManager::enrollStudentToCourse(int studentId, int courseId, int teacherId)
 {
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     query.prepare("INSERT OR IGNORE INTO enrollments (courseId, studentId, enrolledAt, enrolledBy) VALUES (:courseId, :studentId, :enrolledAt, :enrolledBy)");
     query.bindValue(":courseId", courseId);
     query.bindValue(":studentId", studentId);
@@ -185,13 +442,13 @@ bool DatabaseManager::enrollStudentToCourse(int studentId, int courseId, int tea
     return query.exec();
 }
 
-Student DatabaseManager::addNewStudentAndEnroll(const QString& cardUID, const QString& studentNumber, const QString& firstName, const QString& lastName, int teacherId, int courseId)
+Student DatabaseManager::addNewStudentAndEnroll(const CardUid& cardUID, const QString& studentNumber, const QString& firstName, const QString& lastName, int teacherId, int courseId)
 {
     m_db.transaction();
     QSqlQuery query(m_db);
     query.prepare("INSERT INTO students (cardUID, studentNumber, firstName, lastName, createdAt, createdBy) "
                   "VALUES (:cardUID, :studentNumber, :firstName, :lastName, :createdAt, :createdBy)");
-    query.bindValue(":cardUID", cardUID);
+    query.bindValue(":cardUID", cardUID.toByteArray());
     query.bindValue(":studentNumber", studentNumber);
     query.bindValue(":firstName", firstName);
     query.bindValue(":lastName", lastName);
@@ -216,14 +473,16 @@ Student DatabaseManager::addNewStudentAndEnroll(const QString& cardUID, const QS
     
     Student newStudent;
     newStudent.id = newStudentId;
+    newStudent.studentNumber = studentNumber;
     newStudent.firstName = firstName;
     newStudent.lastName = lastName;
+    newStudent.cardUID = cardUID;
     return newStudent;
 }
 
 bool DatabaseManager::markStudentPresent(int sessionId, int studentId, int& rowsAffected)
 {
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     query.prepare("INSERT OR IGNORE INTO attendanceRecords (sessionId, studentId, time, status) "
                         "VALUES (:sessionId, :studentId, :time, 'present')");
     query.bindValue(":sessionId", sessionId);
@@ -238,13 +497,130 @@ bool DatabaseManager::markStudentPresent(int sessionId, int studentId, int& rows
     return false;
 }
 
+void DatabaseManager::prepareTapQueries()
+{
+    // Öğrenci, ders kaydı ve mevcut yoklama durumu tek sorguda çözülür
+    m_tapLookupQuery = QSqlQuery(m_db);
+    m_tapLookupQuery.prepare(kSqlTapLookup);
+
+    m_tapInsertQuery = QSqlQuery(m_db);
+    m_tapInsertQuery.prepare("INSERT OR IGNORE INTO attendanceRecords (sessionId, studentId, time, status) "
+                             "VALUES (:sessionId, :studentId, :time, 'present')");
+
+    m_tapQueriesPrepared = true;
+}
+
+CardTapResult DatabaseManager::recordCardTap(int sessionId, const CardUid& cardUID)
+{
+    CardTapResult result;
+    if (!m_tapQueriesPrepared) {
+        prepareTapQueries();
+    }
+
+    m_db.transaction();
+
+    m_tapLookupQuery.bindValue(":sessionId", sessionId);
+    m_tapLookupQuery.bindValue(":cardUID", cardUID.toByteArray());
+    if (!m_tapLookupQuery.exec()) {
+        qDebug() << "Kart sorgulama hatası:" << m_tapLookupQuery.lastError().text();
+        m_db.rollback();
+        return result;
+    }
+
+    if (!m_tapLookupQuery.next()) {
+        m_tapLookupQuery.finish();
+        m_db.commit();
+        result.outcome = CardTapOutcome::UnknownCard;
+        return result;
+    }
+
+    result.student.id = m_tapLookupQuery.value(0).toInt();
+    result.student.studentNumber = m_tapLookupQuery.value(1).toString();
+    result.student.firstName = m_tapLookupQuery.value(2).toString();
+    result.student.lastName = m_tapLookupQuery.value(3).toString();
+    result.student.cardUID = CardUid::fromByteArray(m_tapLookupQuery.value(4).toByteArray());
+    bool enrolled = m_tapLookupQuery.value(5).toBool();
+    bool present = m_tapLookupQuery.value(6).toBool();
+    m_tapLookupQuery.finish();
+
+    if (!enrolled) {
+        m_db.commit();
+        result.outcome = CardTapOutcome::NotEnrolled;
+        return result;
+    }
+    if (present) {
+        m_db.commit();
+        result.outcome = CardTapOutcome::AlreadyPresent;
+        return result;
+    }
+
+    m_tapInsertQuery.bindValue(":sessionId", sessionId);
+    m_tapInsertQuery.bindValue(":studentId", result.student.id);
+    m_tapInsertQuery.bindValue(":time", QDateTime::currentDateTime().toString(Qt::ISODate));
+    if (!m_tapInsertQuery.exec()) {
+        qDebug() << "Yoklamaya ekleme hatası:" << m_tapInsertQuery.lastError().text();
+        m_db.rollback();
+        return result;
+    }
+
+    result.outcome = m_tapInsertQuery.numRowsAffected() > 0 ? CardTapOutcome::PresentNew
+                                                           : CardTapOutcome::AlreadyPresent;
+    m_db.commit();
+    return result;
+}
+
+QVector<SessionRosterEntry> DatabaseManager::getSessionRoster(int sessionId)
+{
+    QVector<SessionRosterEntry> roster;
+    QSqlQuery query(connection());
+    query.prepare(kSqlSessionRoster);
+    query.bindValue(":sessionId", sessionId);
+
+    if (query.exec()) {
+        readRosterEntries(query, roster);
+    } else {
+        qDebug() << "Oturum öğrenci listesi alınamadı:" << query.lastError().text();
+    }
+    return roster;
+}
+
+QVector<SessionRosterEntry> DatabaseManager::getCourseRosterWithStatus(int courseId, int sessionId)
+{
+    QVector<SessionRosterEntry> roster;
+    QSqlQuery query(connection());
+    query.prepare(kSqlCourseRosterStatus);
+    query.bindValue(":courseId", courseId);
+    // Oturum yoksa LEFT JOIN hiçbir kayıtla eşleşmez, herkes "yok" döner
+    query.bindValue(":sessionId", sessionId);
+
+    if (query.exec()) {
+        readRosterEntries(query, roster);
+    } else {
+        qDebug() << "Ders öğrenci listesi alınamadı:" << query.lastError().text();
+    }
+    return roster;
+}
+
+void DatabaseManager::readRosterEntries(QSqlQuery& query, QVector<SessionRosterEntry>& roster)
+{
+    // Sütunlar: id, studentNumber, firstName, lastName, cardUID, kayıt zamanı (yoksa NULL)
+    while (query.next()) {
+        SessionRosterEntry entry;
+        entry.student = {query.value(0).toInt(), query.value(1).toString(), query.value(2).toString(),
+                         query.value(3).toString(), CardUid::fromByteArray(query.value(4).toByteArray())};
+        entry.present = !query.value(5).isNull();
+        if (entry.present) {
+            entry.time = QDateTime::fromString(query.value(5).toString(), Qt::ISODate).toString("HH:mm:ss");
+        }
+        roster.append(entry);
+    }
+}
+
 QVector<AttendanceRecord> DatabaseManager::getAttendanceForSession(int sessionId)
 {
     QVector<AttendanceRecord> records;
-    QSqlQuery query(m_db);
-    query.prepare("SELECT s.studentNumber, s.firstName, s.lastName, r.time FROM students s "
-                  "JOIN attendanceRecords r ON s.id = r.studentId "
-                  "WHERE r.sessionId = :sessionId ORDER BY r.time DESC");
+    QSqlQuery query(connection());
+    query.prepare(kSqlAttendanceForSession);
     query.bindValue(":sessionId", sessionId);
     
     if (query.exec()) {
@@ -263,7 +639,7 @@ QVector<AttendanceRecord> DatabaseManager::getAttendanceForSession(int sessionId
 QVector<Teacher> DatabaseManager::getAllTeachers()
 {
     QVector<Teacher> teachers;
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     if (query.exec("SELECT id, fullName, username, email, role FROM users WHERE role = 'teacher' ORDER BY fullName")) {
         while (query.next()) {
             Teacher teacher;
@@ -306,7 +682,7 @@ QVector<CourseWithTeacher> DatabaseManager::getAllCoursesWithTeachers()
 
 bool DatabaseManager::addTeacher(const QString& username, const QString& password, const QString& fullName, const QString& email)
 {
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     query.prepare("INSERT INTO users (username, password, fullName, role, email, createdAt) "
                   "VALUES (:username, :password, :fullName, 'teacher', :email, :createdAt)");
     query.bindValue(":username", username);
@@ -344,7 +720,7 @@ bool DatabaseManager::addCourse(const QString& courseName, const QString& course
 QVector<Course> DatabaseManager::getAllCourses()
 {
     QVector<Course> courses;
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     query.prepare("SELECT id, course_name, course_code, teacher_id, created_by, created_at "
                     "FROM courses ORDER BY course_name");
     
@@ -405,94 +781,18 @@ bool DatabaseManager::deleteCourse(int courseId)
     }
 }
 
-QVector<AttendanceSession> DatabaseManager::getTeacherAttendanceHistory(int teacherId)
+SessionPage<AttendanceSession> DatabaseManager::getTeacherAttendanceHistoryPage(int teacherId, const SessionPageCursor& after, int limit)
 {
-    QVector<AttendanceSession> sessions;
-    QSqlQuery query(m_db);
-    
-    // SQL sorgusunu debug et
-    QString sqlQuery = "SELECT s.id, s.title, s.start_time, s.end_time, s.is_active, c.course_name, c.course_code, "
-                      "(SELECT COUNT(*) FROM attendanceRecords WHERE sessionId = s.id) as student_count "
-                      "FROM attendance_sessions s "
-                      "JOIN courses c ON s.course_id = c.id "
-                      "WHERE s.teacher_id = :teacherId "
-                      "ORDER BY s.start_time DESC";
-    
-    qDebug() << "SQL sorgusu:" << sqlQuery;
-    
-    query.prepare(sqlQuery);
+    QSqlQuery query(connection());
+    query.prepare(kSqlTeacherHistoryPage);
     query.bindValue(":teacherId", teacherId);
-    
-    if (query.exec()) {
-        while (query.next()) {
-            AttendanceSession session;
-            session.id = query.value("id").toInt();
-            session.title = query.value("title").toString();
-            QDateTime utcStart = QDateTime::fromString(query.value("start_time").toString(), "yyyy-MM-dd HH:mm:ss");
-            utcStart.setTimeSpec(Qt::UTC);
-            session.startTime = utcStart.toLocalTime();
-            QDateTime utcEnd = QDateTime::fromString(query.value("end_time").toString(), "yyyy-MM-dd HH:mm:ss");
-            utcEnd.setTimeSpec(Qt::UTC);
-            session.endTime = utcEnd.toLocalTime();
-            session.isActive = query.value("is_active").toBool();
-            session.courseName = query.value("course_name").toString();
-            session.courseCode = query.value("course_code").toString();
-            session.studentCount = query.value("student_count").toInt();
-            sessions.append(session);
-        }
-    } else {
-        qDebug() << "Yoklama geçmişi alınırken hata:" << query.lastError().text();
-    }
-    
-    return sessions;
-}
-
-QVector<AttendanceSession> DatabaseManager::getAttendanceSessionsForCourse(int courseId)
-{
-    QVector<AttendanceSession> sessions;
-    QSqlQuery query(m_db);
-    
-    // SQL sorgusunu debug et
-    QString sqlQuery = "SELECT s.id, s.title, s.start_time, s.end_time, s.is_active, c.course_name, c.course_code, "
-                      "(SELECT COUNT(*) FROM attendanceRecords WHERE sessionId = s.id) as student_count "
-                      "FROM attendance_sessions s "
-                      "JOIN courses c ON s.course_id = c.id "
-                      "WHERE s.course_id = :courseId "
-                      "ORDER BY s.start_time DESC";
-    
-    qDebug() << "SQL sorgusu:" << sqlQuery;
-    
-    query.prepare(sqlQuery);
-    query.bindValue(":courseId", courseId);
-    
-    if (query.exec()) {
-        while (query.next()) {
-            AttendanceSession session;
-            session.id = query.value("id").toInt();
-            session.title = query.value("title").toString();
-            QDateTime utcStart = QDateTime::fromString(query.value("start_time").toString(), "yyyy-MM-dd HH:mm:ss");
-            utcStart.setTimeSpec(Qt::UTC);
-            session.startTime = utcStart.toLocalTime();
-            QDateTime utcEnd = QDateTime::fromString(query.value("end_time").toString(), "yyyy-MM-dd HH:mm:ss");
-            utcEnd.setTimeSpec(Qt::UTC);
-            session.endTime = utcEnd.toLocalTime();
-            session.isActive = query.value("is_active").toBool();
-            session.courseName = query.value("course_name").toString();
-            session.courseCode = query.value("course_code").toString();
-            session.studentCount = query.value("student_count").toInt();
-            sessions.append(session);
-        }
-    } else {
-        qDebug() << "Ders için yoklama geçmişi alınırken hata:" << query.lastError().text();
-    }
-    
-    return sessions;
+    return execSessionPage<AttendanceSession>(query, after, limit, readAttendanceSession);
 }
 
 int DatabaseManager::getActiveSessionId(int teacherId)
 {
-    QSqlQuery query(m_db);
-    query.prepare("SELECT id FROM attendance_sessions WHERE teacher_id = ? AND is_active = 1");
+    QSqlQuery query(connection());
+    query.prepare(kSqlActiveSession);
     query.addBindValue(teacherId);
     
     if (query.exec() && query.next()) {
@@ -503,7 +803,7 @@ int DatabaseManager::getActiveSessionId(int teacherId)
 
 int DatabaseManager::getCourseIdForSession(int sessionId)
 {
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     query.prepare("SELECT course_id FROM attendance_sessions WHERE id = ?");
     query.addBindValue(sessionId);
     
@@ -513,12 +813,20 @@ int DatabaseManager::getCourseIdForSession(int sessionId)
     return -1;
 }
 
+SessionPage<AttendanceSession> DatabaseManager::getAttendanceSessionsForCoursePage(int courseId, const SessionPageCursor& after, int limit)
+{
+    QSqlQuery query(connection());
+    query.prepare(kSqlCourseSessionsPage);
+    query.bindValue(":courseId", courseId);
+    return execSessionPage<AttendanceSession>(query, after, limit, readAttendanceSession);
+}
+
 AttendanceSessionDetail DatabaseManager::getAttendanceSessionDetails(int sessionId)
 {
     qDebug() << "getAttendanceSessionDetails çağrıldı, sessionId:" << sessionId;
     
     AttendanceSessionDetail detail;
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     
     // Oturum bilgilerini al
     query.prepare("SELECT id, title, start_time, end_time, is_active FROM attendance_sessions WHERE id = :sessionId");
@@ -552,7 +860,7 @@ AttendanceSessionDetail DatabaseManager::getAttendanceSessionDetails(int session
 
 bool DatabaseManager::changePassword(int userId, const QString& newPassword)
 {
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     query.prepare("UPDATE users SET password = :password WHERE id = :userId");
     query.bindValue(":password", newPassword);
     query.bindValue(":userId", userId);
@@ -568,7 +876,7 @@ bool DatabaseManager::changePassword(int userId, const QString& newPassword)
 
 bool DatabaseManager::changeOwnPassword(int userId, const QString& currentPassword, const QString& newPassword)
 {
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     query.prepare("SELECT password FROM users WHERE id = :userId");
     query.bindValue(":userId", userId);
     
@@ -588,7 +896,7 @@ bool DatabaseManager::changeOwnPassword(int userId, const QString& currentPasswo
 
 bool DatabaseManager::changeEmail(int userId, const QString& currentEmail, const QString& newEmail)
 {
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     
     // Önce mevcut email'i kontrol et
     query.prepare("SELECT email FROM users WHERE id = :userId");
@@ -631,7 +939,7 @@ bool DatabaseManager::changeEmail(int userId, const QString& currentEmail, const
 
 bool DatabaseManager::changePasswordByEmail(const QString& username, const QString& email, const QString& newPassword)
 {
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     
     // Kullanıcı adı ve email'i doğrula
     query.prepare("SELECT id FROM users WHERE username = :username AND email = :email");
@@ -665,7 +973,7 @@ bool DatabaseManager::changePasswordByEmail(const QString& username, const QStri
 
 bool DatabaseManager::requestAttendanceDeletion(int sessionId, int teacherId, const QString& reason)
 {
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     query.prepare("INSERT INTO attendanceDeleteRequests (sessionId, requestedBy, requestedAt, reason, status) "
                   "VALUES (:sessionId, :requestedBy, :requestedAt, :reason, 'pending')");
     query.bindValue(":sessionId", sessionId);
@@ -685,15 +993,9 @@ bool DatabaseManager::requestAttendanceDeletion(int sessionId, int teacherId, co
 QVector<AttendanceDeleteRequest> DatabaseManager::getPendingDeleteRequests()
 {
     QVector<AttendanceDeleteRequest> requests;
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     
-    query.prepare("SELECT r.id, r.sessionId, r.requestedAt, r.reason, r.status, "
-                  "s.title as sessionTitle, u.fullName as teacherName "
-                  "FROM attendanceDeleteRequests r "
-                  "JOIN attendance_sessions s ON r.sessionId = s.id "
-                  "JOIN users u ON r.requestedBy = u.id "
-                  "WHERE r.status = 'pending' "
-                  "ORDER BY r.requestedAt DESC");
+    query.prepare(kSqlPendingDeleteRequests);
     
     if (query.exec()) {
         while (query.next()) {
@@ -756,7 +1058,7 @@ bool DatabaseManager::approveDeleteRequest(int requestId)
 
 bool DatabaseManager::rejectDeleteRequest(int requestId)
 {
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     query.prepare("UPDATE attendanceDeleteRequests SET status = 'rejected', approvedAt = :approvedAt "
                   "WHERE id = :requestId");
     query.bindValue(":approvedAt", QDateTime::currentDateTime().toString(Qt::ISODate));
@@ -805,46 +1107,16 @@ bool DatabaseManager::deleteAttendanceSession(int sessionId)
 //   ADMİN YOKLAMA GENEL BAKIŞ
 // ===================================================================
 
-QVector<AdminAttendanceOverview> DatabaseManager::getAdminAttendanceOverview()
+SessionPage<AdminAttendanceOverview> DatabaseManager::getAdminAttendanceOverviewPage(const SessionPageCursor& after, int limit)
 {
-    QVector<AdminAttendanceOverview> overview;
-    QSqlQuery query(m_db);
-    
-    query.prepare("SELECT s.id, s.title, s.start_time, s.is_active, "
-                  "c.course_name, u.fullName as teacherName, "
-                  "COUNT(r.id) as studentCount "
-                  "FROM attendance_sessions s "
-                  "JOIN courses c ON s.course_id = c.id "
-                  "JOIN users u ON s.teacher_id = u.id "
-                  "LEFT JOIN attendanceRecords r ON s.id = r.sessionId "
-                  "GROUP BY s.id, s.title, s.start_time, s.is_active, c.course_name, u.fullName "
-                  "ORDER BY s.start_time DESC");
-    
-    if (query.exec()) {
-        while (query.next()) {
-            AdminAttendanceOverview item;
-            item.sessionId = query.value("id").toInt();
-            item.sessionTitle = query.value("title").toString();
-            item.teacherName = query.value("teacherName").toString();
-            item.courseName = query.value("course_name").toString();
-            QDateTime utc = QDateTime::fromString(query.value("start_time").toString(), "yyyy-MM-dd HH:mm:ss");
-            utc.setTimeSpec(Qt::UTC);
-            QDateTime local = utc.toLocalTime();
-            item.date = local.toString("dd.MM.yyyy");
-            item.startTime = local.toString("HH:mm");
-            item.status = query.value("is_active").toBool() ? "active" : "completed";
-            item.studentCount = query.value("studentCount").toInt();
-            overview.append(item);
-        }
-    } else {
-        qDebug() << "Yoklama genel bakış alınamadı:" << query.lastError().text();
-    }
-    
-    return overview;
+    QSqlQuery query(connection());
+    query.prepare(kSqlAdminOverviewPage);
+    return execSessionPage<AdminAttendanceOverview>(query, after, limit, readAdminOverview);
 }
 
 int DatabaseManager::getLastInsertId() const
 {
+    // last_insert_rowid bağlantıya özeldir; eklemeler ana bağlantıdan yapılır
     QSqlQuery query(m_db);
     query.exec("SELECT last_insert_rowid()");
     if (query.next()) {
@@ -859,7 +1131,7 @@ int DatabaseManager::getLastInsertId() const
 
 bool DatabaseManager::assignCourseToTeacher(int courseId, int teacherId)
 {
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     query.prepare("UPDATE courses SET teacher_id = :teacherId WHERE id = :courseId");
     query.bindValue(":teacherId", teacherId);
     query.bindValue(":courseId", courseId);
@@ -880,18 +1152,12 @@ bool DatabaseManager::assignCourseToTeacher(int courseId, int teacherId)
 QVector<AttendanceDetail> DatabaseManager::getAttendanceDetails(int sessionId)
 {
     QVector<AttendanceDetail> details;
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     
-    query.prepare("SELECT s.studentNumber, s.firstName, s.lastName, "
-                  "CASE WHEN ar.id IS NOT NULL THEN 'present' ELSE 'absent' END as status "
-                  "FROM students s "
-                  "JOIN enrollments e ON s.id = e.studentId "
-                  "LEFT JOIN attendanceRecords ar ON s.id = ar.studentId AND ar.sessionId = :sessionId "
-                  "WHERE e.courseId = :courseId "
-                  "ORDER BY s.lastName, s.firstName");
+    query.prepare(kSqlAttendanceDetails);
     
     // Önce bu yoklama oturumunun ders ID'sini al
-    QSqlQuery courseQuery(m_db);
+    QSqlQuery courseQuery(connection());
     courseQuery.prepare("SELECT course_id FROM attendance_sessions WHERE id = :sessionId");
     courseQuery.bindValue(":sessionId", sessionId);
     
@@ -924,7 +1190,7 @@ QVector<AttendanceDetail> DatabaseManager::getAttendanceDetails(int sessionId)
 
 bool DatabaseManager::changeTeacherPassword(const QString& username, const QString& newPassword)
 {
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     query.prepare("UPDATE users SET password = :password WHERE username = :username AND role = 'teacher'");
     query.bindValue(":password", newPassword);
     query.bindValue(":username", username);
@@ -941,7 +1207,7 @@ bool DatabaseManager::changeTeacherPassword(const QString& username, const QStri
 bool DatabaseManager::removeTeacher(const QString& username)
 {
     // Önce öğretmenin derslerini kontrol et
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     query.prepare("SELECT COUNT(*) FROM courses WHERE teacher_id = (SELECT id FROM users WHERE username = :username)");
     query.bindValue(":username", username);
     
@@ -971,7 +1237,7 @@ void DatabaseManager::debugDatabaseTables()
     qDebug() << "=== VERİTABANI TABLOLARI DEBUG ===";
     
     // Tüm tabloları listele
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     query.exec("SELECT name FROM sqlite_master WHERE type='table' ORDER BY name");
     qDebug() << "Mevcut tablolar:";
     while (query.next()) {
@@ -979,7 +1245,7 @@ void DatabaseManager::debugDatabaseTables()
         qDebug() << "- Tablo:" << tableName;
         
         // Her tablonun sütunlarını listele
-        QSqlQuery columnsQuery(m_db);
+        QSqlQuery columnsQuery(connection());
         columnsQuery.exec("PRAGMA table_info(" + tableName + ")");
         while (columnsQuery.next()) {
             qDebug() << "  - Sütun:" << columnsQuery.value(1).toString() 
@@ -990,9 +1256,100 @@ void DatabaseManager::debugDatabaseTables()
     qDebug() << "=== DEBUG TAMAMLANDI ===";
 }
 
+bool DatabaseManager::verifyQueryPlans()
+{
+    // Her sık sorgunun planını çıkar; büyük tablolarda indekssiz tam tarama varsa uyar.
+    // scanAllowed: taranmasına izin verilen küçük tabloların takma adları.
+    struct PlanCheck {
+        const char* name;
+        const char* sql;
+        QStringList scanAllowed;
+    };
+    const PlanCheck checks[] = {
+        {"getStudentsForCourse", kSqlStudentsForCourse, {}},
+        {"getStudentByCardUID", kSqlStudentByCardUID, {}},
+        {"recordCardTap", kSqlTapLookup, {}},
+        {"getSessionRoster", kSqlSessionRoster, {}},
+        {"getCourseRosterWithStatus", kSqlCourseRosterStatus, {}},
+        {"getAttendanceForSession", kSqlAttendanceForSession, {}},
+        {"getTeacherAttendanceHistoryPage", kSqlTeacherHistoryPage, {}},
+        {"getAttendanceSessionsForCoursePage", kSqlCourseSessionsPage, {}},
+        {"getActiveSessionId", kSqlActiveSession, {}},
+        {"getPendingDeleteRequests", kSqlPendingDeleteRequests, {}},
+        {"getAdminAttendanceOverviewPage", kSqlAdminOverviewPage, {"c", "u"}},
+        {"getAttendanceDetails", kSqlAttendanceDetails, {}},
+        {"getCoursesForStudent", kSqlCoursesForStudent, {"c"}},
+        {"getStudentAttendanceForCourse", kSqlStudentAttendanceForCourse, {}},
+    };
+
+    bool allIndexed = true;
+    for (const auto& check : checks) {
+        QSqlQuery query(connection());
+        if (!query.prepare(QString("EXPLAIN QUERY PLAN ") + check.sql)) {
+            qWarning() << "Sorgu planı alınamadı:" << check.name << query.lastError().text();
+            allIndexed = false;
+            continue;
+        }
+        for (int i = 0; i < query.boundValues().size(); ++i) {
+            query.bindValue(i, 0);
+        }
+        if (!query.exec()) {
+            qWarning() << "Sorgu planı alınamadı:" << check.name << query.lastError().text();
+            allIndexed = false;
+            continue;
+        }
+
+        while (query.next()) {
+            // Sütunlar: id, parent, notused, detail
+            QString detail = query.value(3).toString();
+            if (!detail.startsWith("SCAN ") || detail.contains(" USING ")) continue;
+
+            QString target = detail.section(' ', 1, 1);
+            if (target == "CONSTANT" || check.scanAllowed.contains(target)) continue;
+
+            qWarning() << "Tam tablo taraması:" << check.name << "-" << detail;
+            allIndexed = false;
+        }
+    }
+
+    qDebug() << "Sorgu planı kontrolü:" << (allIndexed ? "tüm sorgular indeksli" : "taramalar var");
+    return allIndexed;
+}
+
+int DatabaseManager::checkAttendeeCounts(bool rebuild)
+{
+    // attendee_count tetikleyicilerle tutulur; tetikleyiciler devre dışıyken yapılan
+    // toplu işlemlerden sonra sayaçlar buradan yeniden hesaplanabilir
+    const QString actualCount = "(SELECT COUNT(*) FROM attendanceRecords r "
+                                "WHERE r.sessionId = attendance_sessions.id)";
+
+    QSqlQuery query(connection());
+    if (!query.exec("SELECT COUNT(*) FROM attendance_sessions WHERE attendee_count <> " + actualCount)
+        || !query.next()) {
+        qDebug() << "Katılımcı sayaçları kontrol edilemedi:" << query.lastError().text();
+        return -1;
+    }
+
+    int mismatched = query.value(0).toInt();
+    if (mismatched == 0) {
+        return 0;
+    }
+
+    qWarning() << "Katılımcı sayısı tutarsız oturum sayısı:" << mismatched;
+    if (rebuild) {
+        if (!query.exec("UPDATE attendance_sessions SET attendee_count = " + actualCount
+                        + " WHERE attendee_count <> " + actualCount)) {
+            qDebug() << "Katılımcı sayaçları yeniden hesaplanamadı:" << query.lastError().text();
+            return -1;
+        }
+        qDebug() << "Katılımcı sayaçları yeniden hesaplandı:" << query.numRowsAffected() << "oturum";
+    }
+    return mismatched;
+}
+
 QVariant DatabaseManager::authenticateStudent(const QString& studentNumber, const QString& password, User& user)
 {
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     // Şimdilik sadece öğrenci numarası ile giriş (şifre yoksa)
     query.prepare("SELECT id, firstName, lastName FROM students WHERE studentNumber = :studentNumber");
     query.bindValue(":studentNumber", studentNumber);
@@ -1011,11 +1368,8 @@ QVariant DatabaseManager::authenticateStudent(const QString& studentNumber, cons
 QVector<Course> DatabaseManager::getCoursesForStudent(int studentId)
 {
     QVector<Course> courses;
-    QSqlQuery query(m_db);
-    query.prepare("SELECT c.id, c.course_name, c.course_code, c.teacher_id, c.created_by, c.created_at "
-                  "FROM courses c "
-                  "JOIN enrollments e ON c.id = e.courseId "
-                  "WHERE e.studentId = :studentId");
+    QSqlQuery query(connection());
+    query.prepare(kSqlCoursesForStudent);
     query.bindValue(":studentId", studentId);
     if (query.exec()) {
         while (query.next()) {
@@ -1032,9 +1386,39 @@ QVector<Course> DatabaseManager::getCoursesForStudent(int studentId)
     return courses;
 }
 
+QVector<StudentAttendanceEntry> DatabaseManager::getStudentAttendanceForCourse(int studentId, int courseId)
+{
+    QVector<StudentAttendanceEntry> entries;
+    QSqlQuery query(connection());
+    query.prepare(kSqlStudentAttendanceForCourse);
+    query.bindValue(":studentId", studentId);
+    query.bindValue(":courseId", courseId);
+
+    if (!query.exec()) {
+        qDebug() << "Öğrenci yoklama geçmişi alınırken hata:" << query.lastError().text();
+        return entries;
+    }
+
+    while (query.next()) {
+        StudentAttendanceEntry entry;
+        entry.sessionId = query.value(0).toInt();
+        entry.title = query.value(1).toString();
+        QDateTime utcStart = QDateTime::fromString(query.value(2).toString(), "yyyy-MM-dd HH:mm:ss");
+        utcStart.setTimeSpec(Qt::UTC);
+        entry.startTime = utcStart.toLocalTime();
+        entry.courseName = query.value(3).toString();
+        entry.present = !query.value(4).isNull();
+        if (entry.present) {
+            entry.time = QDateTime::fromString(query.value(4).toString(), Qt::ISODate).toString("HH:mm:ss");
+        }
+        entries.append(entry);
+    }
+    return entries;
+}
+
 bool DatabaseManager::changeStudentPassword(const QString& studentNumber, const QString& newPassword)
 {
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     query.prepare("UPDATE students SET password = :password WHERE studentNumber = :studentNumber");
     query.bindValue(":password", newPassword);
     query.bindValue(":studentNumber", studentNumber);
@@ -1055,14 +1439,14 @@ Student DatabaseManager::getStudentById(int studentId)
         student.studentNumber = query.value(1).toString();
         student.firstName = query.value(2).toString();
         student.lastName = query.value(3).toString();
-        student.cardUID = query.value(4).toString();
+        student.cardUID = CardUid::fromByteArray(query.value(4).toByteArray());
     }
     return student;
 }
 
 Student DatabaseManager::getStudentByNumber(const QString& studentNumber)
 {
-    QSqlQuery query(m_db);
+    QSqlQuery query(connection());
     query.prepare("SELECT id, studentNumber, firstName, lastName, cardUID FROM students WHERE studentNumber = :studentNumber");
     query.bindValue(":studentNumber", studentNumber);
     if (query.exec() && query.next()) {
@@ -1071,7 +1455,7 @@ Student DatabaseManager::getStudentByNumber(const QString& studentNumber)
         student.studentNumber = query.value("studentNumber").toString();
         student.firstName = query.value("firstName").toString();
         student.lastName = query.value("lastName").toString();
-        student.cardUID = query.value("cardUID").toString();
+        student.cardUID = CardUid::fromByteArray(query.value("cardUID").toByteArray());
         return student;
     }
     return Student(); // id = -1 olan boş öğrenci
@@ -7,6 +7,11 @@
 #include <QVariant>
 #include <QVector>
 #include <QDateTime>
+#include <QThreadPool>
+#include <QFuture>
+#include <QtConcurrent/QtConcurrentRun>
+#include <type_traits>
+#include "carduid.h"
 
 // Veri transferi için basit yapılar (structs)
 struct User {
@@ -29,7 +34,7 @@ struct Student {
     QString studentNumber;
     QString firstName;
     QString lastName;
-    QString cardUID;
+    CardUid cardUID;
 };
 
 struct Teacher {
@@ -75,6 +80,22 @@ struct AttendanceSession {
     int studentCount;
 };
 
+// Oturum listelerinde sayfa imleci: önceki sayfanın son satırı. Boş imleç ilk sayfadır.
+struct SessionPageCursor {
+    QString startTime; // Veritabanındaki ham (UTC) start_time metni
+    int id = 0;
+
+    bool isStart() const { return startTime.isEmpty(); }
+};
+
+// En yeni oturumdan eskiye doğru bir sayfa; hasMore ise next ile devam edilir
+template<typename T>
+struct SessionPage {
+    QVector<T> rows;
+    SessionPageCursor next;
+    bool hasMore = false;
+};
+
 struct AttendanceSessionDetail {
     int sessionId;
     QString title;
@@ -106,23 +127,76 @@ struct AdminAttendanceOverview {
     int studentCount;
 };
 
+// Öğrencinin bir dersteki tek oturumluk yoklama durumu
+struct StudentAttendanceEntry {
+    int sessionId;
+    QString title;
+    QString courseName;
+    QDateTime startTime;
+    bool present;
+    QString time;
+};
+
+// Yoklama oturumu başlatılırken belleğe alınan ders listesi satırı
+struct SessionRosterEntry {
+    Student student;
+    bool present = false;
+    QString time;
+};
+
+// Kart okutma sonucu (recordCardTap)
+enum class CardTapOutcome {
+    PresentNew,      // Öğrenci yoklamaya yeni eklendi
+    AlreadyPresent,  // Öğrenci zaten yoklamada
+    NotEnrolled,     // Öğrenci sistemde var ama derse kayıtlı değil
+    UnknownCard,     // Kart sistemde kayıtlı değil
+    Error            // Veritabanı hatası
+};
+
+struct CardTapResult {
+    CardTapOutcome outcome = CardTapOutcome::Error;
+    Student student;
+};
+
 class DatabaseManager
 {
 public:
     static DatabaseManager& instance();
     bool openDatabase(const QString& path);
     void closeDatabase();
+    QString databasePath() const;
+
+    // Çağıran thread'in bağlantısı: veritabanını açan (arayüz) thread'de ana bağlantı,
+    // diğer thread'lerde aynı dosyaya açılmış, o thread'e özel salt okunur bağlantı
+    QSqlDatabase connection() const;
+
+    // fn(DatabaseManager&) sorgu havuzundaki bir thread'de çalışır, sonucu QFuture ile döner.
+    // fn içinden sadece okuma fonksiyonları çağrılmalı; yazma ve transaction içeren
+    // fonksiyonlar arayüz thread'inde senkron çağrılır.
+    template<typename Fn>
+    auto runAsync(Fn fn) -> QFuture<std::invoke_result_t<Fn, DatabaseManager&>>
+    {
+        return QtConcurrent::run(&m_queryPool, [this, fn]() { return fn(*this); });
+    }
+    // Bekleyen arka plan sorgularını bitirir, sorgu thread'lerini ve bağlantılarını kapatır
+    void waitForQueries();
 
     QVariant authenticateUser(const QString& username, const QString& password, User& user);
     QVector<Course> getCoursesForTeacher(int teacherId);
     QVector<Student> getStudentsForCourse(int courseId);
-    Student getStudentByCardUID(const QString& cardUID);
+    Student getStudentByCardUID(const CardUid& cardUID);
     Student getStudentById(int studentId);
     bool enrollStudentToCourse(int studentId, int courseId, int teacherId);
-    Student addNewStudentAndEnroll(const QString& cardUID, const QString& studentNumber, const QString& firstName, const QString& lastName, int teacherId, int courseId);
+    Student addNewStudentAndEnroll(const CardUid& cardUID, const QString& studentNumber, const QString& firstName, const QString& lastName, int teacherId, int courseId);
     bool markStudentPresent(int sessionId, int studentId, int& rowsAffected);
+    // Tek işlemde kart çözümleme, kayıt kontrolü ve yoklamaya ekleme
+    CardTapResult recordCardTap(int sessionId, const CardUid& cardUID);
+    // Oturumun dersine kayıtlı öğrenciler, kart UID'leri ve yoklama durumları
+    QVector<SessionRosterEntry> getSessionRoster(int sessionId);
+    // Derse kayıtlı öğrenciler ve verilen oturumdaki durumları (soyada göre sıralı)
+    QVector<SessionRosterEntry> getCourseRosterWithStatus(int courseId, int sessionId);
     QVector<AttendanceRecord> getAttendanceForSession(int sessionId);
-    QVector<AttendanceSession> getAttendanceSessionsForCourse(int courseId);
+    SessionPage<AttendanceSession> getAttendanceSessionsForCoursePage(int courseId, const SessionPageCursor& after, int limit);
     AttendanceSessionDetail getAttendanceSessionDetails(int sessionId);
 
     // Admin fonksiyonları
@@ -145,7 +219,7 @@ public:
     bool deleteAttendanceSession(int sessionId);
     
     // Admin yoklama genel bakış
-    QVector<AdminAttendanceOverview> getAdminAttendanceOverview();
+    SessionPage<AdminAttendanceOverview> getAdminAttendanceOverviewPage(const SessionPageCursor& after, int limit);
     QVector<AttendanceDetail> getAttendanceDetails(int sessionId);
 
     // Ders yönetimi
@@ -157,21 +231,28 @@ public:
     // Yoklama oturumu yönetimi
     bool startAttendanceSession(int teacherId, int courseId, const QString& title);
     bool endAttendanceSession(int sessionId);
-    QVector<AttendanceSession> getTeacherAttendanceHistory(int teacherId);
+    SessionPage<AttendanceSession> getTeacherAttendanceHistoryPage(int teacherId, const SessionPageCursor& after, int limit);
     int getActiveSessionId(int teacherId);
     int getCourseIdForSession(int sessionId);
     int getLastInsertId() const;
 
     // Debug fonksiyonları
     void debugDatabaseTables();
+    // Sık sorgular büyük tablolarda tam tarama yapıyorsa false döner
+    bool verifyQueryPlans();
+    // attendee_count sayaçlarını kayıtlarla karşılaştırır, tutarsız oturum sayısını döner
+    // (hata durumunda -1). rebuild true ise tutarsız sayaçlar düzeltilir.
+    int checkAttendeeCounts(bool rebuild = false);
 
     QVariant authenticateStudent(const QString& studentNumber, const QString& password, User& user);
 
     QVector<Course> getCoursesForStudent(int studentId);
+    // Dersin tüm oturumları ve öğrencinin her birindeki durumu (tek sorgu)
+    QVector<StudentAttendanceEntry> getStudentAttendanceForCourse(int studentId, int courseId);
 
     bool changeStudentPassword(const QString& studentNumber, const QString& newPassword);
 
-    bool isStudentEnrolled(const QString& cardUid, int courseId);
+    bool isStudentEnrolled(const CardUid& cardUID, int courseId);
 
     Student getStudentByNumber(const QString& studentNumber);
 
@@ -181,7 +262,21 @@ private:
     DatabaseManager(const DatabaseManager&) = delete;
     DatabaseManager& operator=(const DatabaseManager&) = delete;
 
+    void prepareTapQueries();
+    void readRosterEntries(QSqlQuery& query, QVector<SessionRosterEntry>& roster);
+
     QSqlDatabase m_db;
+    QThread* m_ownerThread = nullptr;
+    // Sorgu thread'leri ana bağlantıya dokunmadan dosya yolunu buradan okur
+    QString m_dbPath;
+
+    // Arka plan sorguları; her thread kendi bağlantısını açar
+    QThreadPool m_queryPool;
+
+    // Kart okutma yolunda tekrar tekrar kullanılan hazır sorgular
+    QSqlQuery m_tapLookupQuery;
+    QSqlQuery m_tapInsertQuery;
+    bool m_tapQueriesPrepared = false;
 };
 
 #endif // DATABASEMANAGER_H 
\ No newline at end of file
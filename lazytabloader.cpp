@@ -0,0 +1,49 @@
+#include "lazytabloader.h"
+#include <QTabWidget>
+#include <QElapsedTimer>
+#include <QDebug>
+
+LazyTabLoader::LazyTabLoader(QTabWidget* tabs)
+    : QObject(tabs)
+    , m_tabs(tabs)
+    , m_started(false)
+{
+    connect(m_tabs, &QTabWidget::currentChanged, this, [this](int index) {
+        ensureLoaded(m_tabs->widget(index));
+    });
+}
+
+void LazyTabLoader::setLoader(QWidget* tab, std::function<void()> load)
+{
+    m_loaders.insert(tab, load);
+    m_stale.insert(tab); // Henüz hiç yüklenmedi
+}
+
+void LazyTabLoader::start()
+{
+    m_started = true;
+    ensureLoaded(m_tabs->currentWidget());
+}
+
+void LazyTabLoader::markStale(QWidget* tab, bool reloadIfVisible)
+{
+    if (!m_loaders.contains(tab)) return;
+    m_stale.insert(tab);
+    if (reloadIfVisible && m_tabs->currentWidget() == tab) {
+        ensureLoaded(tab);
+    }
+}
+
+void LazyTabLoader::ensureLoaded(QWidget* tab)
+{
+    if (!m_started || !tab || !m_stale.contains(tab)) return;
+
+    // Yükleyici tekrar markStale çağırabilir; önce işaret kaldırılır
+    m_stale.remove(tab);
+
+    // Arka planda devam eden sorgular hariç, sekmeyi açarken arayüzün beklediği süre
+    QElapsedTimer timer;
+    timer.start();
+    m_loaders.value(tab)();
+    qDebug() << "Sekme yüklendi:" << tab->objectName() << timer.elapsed() << "ms";
+}
@@ -0,0 +1,41 @@
+#ifndef LAZYTABLOADER_H
+#define LAZYTABLOADER_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <functional>
+
+class QTabWidget;
+class QWidget;
+
+// Sekme verilerini girişte hepsini birden değil, sekme ilk açıldığında yükler.
+// Veri değiştiğinde sekme "eski" işaretlenir; görünüyorsa hemen, değilse bir sonraki
+// açılışında yeniden yüklenir. Sekmeye geri dönmek tek başına sorgu çalıştırmaz.
+class LazyTabLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit LazyTabLoader(QTabWidget* tabs);
+
+    // tab: QTabWidget'taki sayfa; yükleyici ilk açılışta ve eski işaretlendikten sonra çağrılır
+    void setLoader(QWidget* tab, std::function<void()> load);
+
+    // start çağrılana kadar hiçbir yükleyici çalışmaz (ör. ComboBox doldurulurken)
+    void start();
+
+    // reloadIfVisible false ise görünen sekme de ancak tekrar açıldığında yenilenir
+    // (sık değişen veride tabloyu her seferinde sıfırlamamak için)
+    void markStale(QWidget* tab, bool reloadIfVisible = true);
+
+private:
+    void ensureLoaded(QWidget* tab);
+
+    QTabWidget* m_tabs;
+    QHash<QWidget*, std::function<void()>> m_loaders;
+    QSet<QWidget*> m_stale;
+    bool m_started;
+};
+
+#endif // LAZYTABLOADER_H
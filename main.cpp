@@ -1,6 +1,7 @@
 #include "mainwindow.h"
 
 #include <QApplication>
+#include <QMessageBox>
 #include <QDebug>
 
 // Veritabanı oluşturma fonksiyonu
@@ -13,6 +14,9 @@ int main(int argc, char *argv[])
     // Veritabanını oluştur
     if (!createDatabase()) {
         qDebug() << "Veritabanı oluşturulamadı!";
+        // Konsolsuz (WIN32) uygulamada kullanıcı başka türlü bir şey görmez
+        QMessageBox::critical(nullptr, "Veritabanı Hatası",
+                              "Veritabanı hazırlanamadı. Ayrıntılar için günlük kayıtlarına bakın.");
         return -1;
     }
     
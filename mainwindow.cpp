@@ -19,23 +19,20 @@
 #include <QFile>
 #include <QStackedWidget>
 #include <QThread>
-#include <QtMultimedia/QMediaPlayer>
-#include <QtMultimedia/QAudioOutput>
 #include <QUrl>
 #include <QCoreApplication>
 #include <QDir>
+#include <QElapsedTimer>
+#include <QSettings>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
     , dbManager(DatabaseManager::instance())
-    , m_serialPort(new QSerialPort(this))
-    , m_pollTimer(new QTimer(this))
     , m_doubleClickTimer(new QTimer(this))
-    , m_readBuffer()
+    , m_currentAttendanceSessionId(-1)
+    , m_isAttendanceActive(false)
     , m_isCardScanModeActive(false)
-    , m_successSound(new QMediaPlayer(this))
-    , m_audioOutput(new QAudioOutput(this))
 {
     qDebug() << "MainWindow yapıcısı başladı";
 
@@ -48,6 +45,9 @@ MainWindow::MainWindow(QWidget *parent)
     // Stil dosyasını yükle
     loadStylesheet();
 
+    // Kart okutma yolundaki mesajlar modal olmayan bildirimlerle gösterilir
+    m_notifications = new NotificationQueue(this);
+
     // Çift tıklama koruması için timer ayarla
     m_doubleClickTimer->setSingleShot(true);
     m_doubleClickTimer->setInterval(500); // 500ms
@@ -56,25 +56,10 @@ MainWindow::MainWindow(QWidget *parent)
         qDebug() << "Çift tıklama koruması sıfırlandı.";
     });
 
-    // Ses altyapısını ayarla (Qt6 uyumlu)
-    m_successSound->setAudioOutput(m_audioOutput);
-    QString soundFilePath = QCoreApplication::applicationDirPath() + "/success.wav";
-    qDebug() << "Ses dosyası yolu kontrol ediliyor:" << soundFilePath;
-    if (!QFile::exists(soundFilePath)) {
-        qWarning() << "!!! SES DOSYASI BULUNAMADI !!! Kontrol edilmesi gereken yol: " << soundFilePath;
-    }
-    m_successSound->setSource(QUrl::fromLocalFile(soundFilePath));
-    m_audioOutput->setVolume(0.8); // 0.0 ile 1.0 arasında
-
-    connect(m_successSound, &QMediaPlayer::errorOccurred, this, [](QMediaPlayer::Error error, const QString &errorString) {
-        qDebug() << "Medya Oynatıcı Hatası:" << error << " - " << errorString;
-    });
-    connect(m_successSound, &QMediaPlayer::mediaStatusChanged, this, [](QMediaPlayer::MediaStatus status) {
-        qDebug() << "Medya Oynatıcı Durumu:" << status;
-        if (status == QMediaPlayer::InvalidMedia) {
-            qDebug() << "Medya geçersiz veya bulunamadı!";
-        }
-    });
+    // Kart okutma ses ipuçları bellekte hazır tutulur; success.wav yoksa ton üretilir
+    m_cues = new AudioCueBank(this);
+    m_cues->load(QCoreApplication::applicationDirPath());
+    m_cues->setVolume(0.8); // 0.0 ile 1.0 arasında
 
     qDebug() << "Veritabanı açılıyor";
     if (!dbManager.openDatabase("yoklama_sistemi.db")) {
@@ -85,6 +70,26 @@ MainWindow::MainWindow(QWidget *parent)
         
         // Veritabanı şemasını kontrol et
         dbManager.debugDatabaseTables();
+
+        // attendee_count sayaçlarını şema göçü (sürüm 3) bir kez doldurur, sonrasını tetikleyiciler
+        // güncel tutar. Tam karşılaştırma yalnızca ayar açıldığında yapılır.
+        QSettings settings("yoklama_ayarlar.ini", QSettings::IniFormat);
+        if (settings.value("Database/checkAttendeeCounts", false).toBool()) {
+            dbManager.checkAttendeeCounts(true);
+        }
+
+        // Yoklama kayıtlarını grup halinde yazan arka plan yazıcısı
+        m_attendanceWriter = new AttendanceWriter(dbManager.databasePath(), this);
+        m_attendanceWriter->setDurability(WriteDurability::Journaled);
+        m_attendanceWriter->setBatchLimits(250, 64);
+        connect(m_attendanceWriter, &AttendanceWriter::writeFailed, this, [](const QString& error) {
+            qWarning() << "Yoklama kayıtları yazılamadı:" << error;
+        });
+        connect(m_attendanceWriter, &AttendanceWriter::recordFailed,
+                this, &MainWindow::onAttendanceRecordFailed);
+        m_attendanceWriter->start();
+
+        m_recentTaps.setWindowMs(settings.value("Attendance/tapDedupWindowMs", 5000).toInt());
         
         setupUI();
         setupCardReader();
@@ -94,9 +99,11 @@ MainWindow::MainWindow(QWidget *parent)
 
 MainWindow::~MainWindow()
 {
-    if (m_serialPort->isOpen()) {
-        m_serialPort->close();
+    if (m_readerPool) {
+        m_readerPool->close();
     }
+    // Arka plan sorguları ve thread'lere özel bağlantılar uygulama kapanmadan biter
+    dbManager.waitForQueries();
     delete ui;
 }
 
@@ -179,6 +186,8 @@ void MainWindow::loadStylesheet()
 
 void MainWindow::onLoginSuccessful(const User& user)
 {
+    QElapsedTimer loginTimer;
+    loginTimer.start();
     currentUser = user;
     
     if (user.role == "admin") {
@@ -200,6 +209,14 @@ void MainWindow::onLoginSuccessful(const User& user)
         connect(m_teacherWidget, &TeacherWidget::attendanceStarted, this, &MainWindow::onAttendanceStarted);
         connect(m_teacherWidget, &TeacherWidget::attendanceEnded, this, &MainWindow::onAttendanceEnded);
         connect(m_teacherWidget, &TeacherWidget::cardScanRequested, this, &MainWindow::teacherCardScanRequested);
+        connect(m_teacherWidget, &TeacherWidget::studentEnrolled, this, &MainWindow::onStudentEnrolled);
+        connect(this, &MainWindow::attendanceRecorded, m_teacherWidget, &TeacherWidget::appendAttendanceRecord);
+
+        // Önceki oturumdan kalan aktif yoklama varsa kart okumayı sürdür
+        int activeSessionId = dbManager.getActiveSessionId(user.id);
+        if (activeSessionId > 0) {
+            onAttendanceStarted(activeSessionId);
+        }
     } else if (user.role == "student") {
         // Öğrenci widget'ını oluştur ve göster
         m_studentWidget = new StudentWidget(user, this);
@@ -213,6 +230,14 @@ void MainWindow::onLoginSuccessful(const User& user)
         connect(m_studentWidget, &StudentWidget::logoutRequested, this, &MainWindow::onLogoutRequested);
         statusBar()->showMessage(QString("Hoşgeldiniz, %1 (Öğrenci)").arg(user.fullName));
     }
+    
+    // Girişten panelin kullanılabilir olmasına kadar geçen süre. Panel oluşturma açık sekmenin
+    // yüklenmesini içerir; olay döngüsüne dönülünce panel çizilmiş ve tıklamaya hazırdır.
+    qint64 buildMs = loginTimer.elapsed();
+    QTimer::singleShot(0, this, [loginTimer, buildMs, role = user.role]() {
+        qDebug() << "Girişten etkileşime:" << loginTimer.elapsed() << "ms (" << role
+                 << "paneli oluşturma" << buildMs << "ms)";
+    });
 }
 
 void MainWindow::onLogoutRequested()
@@ -227,6 +252,7 @@ void MainWindow::onLogoutRequested()
     // Durumu temizle
     currentUser = User();
     statusBar()->clearMessage();
+    m_notifications->clear();
     
     qDebug() << "Kullanıcı çıkış yaptı";
 }
@@ -238,118 +264,65 @@ void MainWindow::onLogoutRequested()
 void MainWindow::setupCardReader()
 {
     qDebug() << "Kart okuyucu kurulumu başlıyor...";
-    
-    m_serialPort->setPortName("COM10"); 
-    m_serialPort->setBaudRate(QSerialPort::Baud115200); // Eski kodda 115200 kullanılıyordu
-    m_serialPort->setDataBits(QSerialPort::Data8);
-    m_serialPort->setParity(QSerialPort::NoParity);
-    m_serialPort->setStopBits(QSerialPort::OneStop);
-    m_serialPort->setFlowControl(QSerialPort::NoFlowControl);
 
-    qDebug() << "Seri port ayarları yapıldı: COM10, 115200 baud";
+    // Her okuyucunun portu, yoklaması ve çerçeve çözmesi kendi thread'inde çalışır
+    m_readerPool = new CardReaderPool(this);
+    connect(m_readerPool, &CardReaderPool::cardTapped, this, &MainWindow::handleCardUid);
+    connect(m_readerPool, &CardReaderPool::readerStateChanged, this,
+            [this](int readerIndex, bool open, const QString& error) {
+        QString portName = m_readerPool->stats(readerIndex).portName;
+        if (open) {
+            qDebug() << "Kart okuyucu hazır:" << portName << "- yoklama başladığında aktif olacak.";
+        } else if (!error.isEmpty()) {
+            // Birden fazla okuyucu açılamazsa iç içe modal pencereler yerine birer bildirim gösterilir
+            qWarning() << "Kart okuyucu portu açılamadı:" << portName << error;
+            m_notifications->post(NotificationKind::Error, "readerError_" + QString::number(readerIndex),
+                QString("Kart okuyucu portu (%1) açılamadı: %2").arg(portName, error), 8000);
+        }
+    });
 
-    if (m_serialPort->open(QIODevice::ReadWrite)) {
-        qDebug() << "Seri port başarıyla açıldı!";
-        
-        connect(m_serialPort, &QSerialPort::readyRead, this, &MainWindow::onSerialPortReadyRead);
-        
-        // Poll timer'ı ayarla ama başlatma
-        m_pollTimer->setInterval(2000); // 2 saniyede bir
-        connect(m_pollTimer, &QTimer::timeout, this, &MainWindow::pollCard);
-        
-        qDebug() << "Seri port COM10 açıldı ve sinyaller bağlandı.";
-        qDebug() << "Kart okuyucu hazır - yoklama başladığında aktif olacak.";
-    } else {
-        qDebug() << "Seri port açılamadı:" << m_serialPort->errorString();
-        QMessageBox::critical(this, "Port Hatası", "Kart okuyucu portu (COM10) açılamadı.");
-    }
+    m_readerPool->openConfigured();
 }
 
 void MainWindow::startCardPolling()
 {
-    if (m_serialPort->isOpen() && !m_pollTimer->isActive()) {
-        m_pollTimer->start(2000); 
-        qDebug() << "Kart okuyucu periyodik yoklama başlatıldı.";
+    if (m_readerPool) {
+        m_readerPool->startPolling();
     }
 }
 
 void MainWindow::stopCardPolling()
 {
-    if (m_pollTimer->isActive()) {
-        m_pollTimer->stop();
-        qDebug() << "Kart okuyucu periyodik yoklama durduruldu.";
+    if (m_readerPool) {
+        m_readerPool->stopPolling();
     }
 }
 
-void MainWindow::pollCard()
+void MainWindow::handleCardUid(const CardUid &uid, int readerIndex, qint64 detectedAtMs)
 {
-    if (!m_serialPort->isOpen()) {
-        qDebug() << "Poll denemesi: Port kapalı.";
+    Q_UNUSED(readerIndex);
+    qDebug() << "UID Bulundu:" << uid;
+
+    // Kart okuma modu aktif mi kontrol et
+    if (m_isCardScanModeActive) {
+        // Kart UID'si forma metin olarak gider
+        emit cardScanned(uid.toString());
+        m_isCardScanModeActive = false;
+        qDebug() << "Kart UID gönderildi:" << uid;
         return;
     }
-    
-    QByteArray pollPacket = createPollPacket();
-    qDebug() << "Kart yoklama komutu gönderiliyor:" << pollPacket.toHex(' ').toUpper();
-    m_serialPort->write(pollPacket);
-}
 
-void MainWindow::onSerialPortReadyRead()
-{
-    m_readBuffer.append(m_serialPort->readAll());
-    
-    if (m_readBuffer.startsWith(STX) && m_readBuffer.endsWith(ETX)) {
-        qDebug() << "Tam bir paket alındı:" << m_readBuffer.toHex(' ').toUpper();
-        processCardResponse(m_readBuffer);
-        m_readBuffer.clear();
-    } else {
-        qDebug() << "Kısmi veri alındı, bekleniyor:" << m_readBuffer.toHex(' ').toUpper();
-    }
-}
-
-void MainWindow::processCardResponse(const QByteArray &response)
-{
-    QByteArray uidTag;
-    uidTag.append(static_cast<char>(0xDF));
-    uidTag.append(static_cast<char>(0x0D));
-
-    int tagIndex = response.indexOf(uidTag);
-    if (tagIndex != -1) {
-        int uidLengthIndex = tagIndex + uidTag.length();
-        if (response.length() > uidLengthIndex) {
-            int uidLength = response.at(uidLengthIndex);
-            int uidStartIndex = uidLengthIndex + 1;
-            
-            if (response.length() >= uidStartIndex + uidLength) {
-                QByteArray uidBytes = response.mid(uidStartIndex, uidLength);
-                QString uidHex = QString(uidBytes.toHex(' ').toUpper());
-                qDebug() << "UID Bulundu:" << uidHex;
-                
-                // Kart okuma modu aktif mi kontrol et
-                if (m_isCardScanModeActive) {
-                    // Kart UID'sini sinyal olarak gönder
-                    emit cardScanned(uidHex);
-                    m_isCardScanModeActive = false;
-                    qDebug() << "Kart UID gönderildi:" << uidHex;
-                    return;
-                }
-                
-                // Aktif yoklama var mı kontrol et
-                if (currentUser.role == "teacher") {
-                    int activeSessionId = dbManager.getActiveSessionId(currentUser.id);
-                    if (activeSessionId > 0) {
-                        processUid(uidHex, activeSessionId);
-                    } else {
-                        qDebug() << "Aktif yoklama bulunamadı";
-                    }
-                }
-            }
+    // Aktif yoklama var mı kontrol et (oturum ID'si başlatılırken saklanır)
+    if (currentUser.role == "teacher") {
+        if (m_isAttendanceActive && m_currentAttendanceSessionId > 0) {
+            processUid(uid, m_currentAttendanceSessionId, detectedAtMs);
+        } else {
+            qDebug() << "Aktif yoklama bulunamadı";
         }
-    } else {
-        qDebug() << "Gelen yanıtta UID (DF 0D) bulunamadı.";
     }
 }
 
-void MainWindow::processUid(const QString &uid, int sessionId)
+void MainWindow::processUid(const CardUid &uid, int sessionId, qint64 detectedAtMs)
 {
     qDebug() << "İşlenen UID:" << uid << "Session ID:" << sessionId;
 
@@ -384,49 +357,95 @@ void MainWindow::processUid(const QString &uid, int sessionId)
 
     // Normal yoklama işlemi
     if (m_isAttendanceActive && sessionId > 0) {
-        Student student = dbManager.getStudentByCardUID(uid);
-
-        if (student.id > 0) {
-            // Yoklamanın yapıldığı dersin ID'sini al
-            int courseId = dbManager.getCourseIdForSession(sessionId);
-            if (courseId <= 0) {
-                qWarning() << "Aktif yoklama otumuru için ders bulunamadı: " << sessionId;
-                QMessageBox::critical(this, "Sistem Hatası", "Yoklama oturumu için ders bilgisi alınamadı.");
-                return;
+        // Pencere içinde aynı kart zaten işlendiyse hiçbir sorguya gitme.
+        // Okuyucu thread'i yalnızca okuyucunun üzerinde duran kartı tekrar yayınlamaz, havuz da
+        // farklı kapılardan 1.5 sn içinde gelen aynı kartı eler; ikisi de oturumu bilmez. Kart
+        // kaldırılıp birkaç saniye içinde yeniden okutulduğunda bu önbellek yakalar. Özellikle
+        // listede olmayan kartlar (bilinmeyen, derse kayıtlı olmayan) her seferinde SQL'e gider.
+        qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+        if (m_recentTaps.contains(sessionId, uid, nowMs)) {
+            qDebug() << "Kart yakın zamanda işlendi, atlandı:" << uid;
+            m_cues->play(AudioCue::Duplicate, detectedAtMs);
+            // Yoklamaya yazılmış öğrenci, AlreadyPresent ile aynı mesajı görür
+            int slot = m_roster.find(uid);
+            if (slot >= 0 && m_roster.isPresent(slot)) {
+                const Student& student = m_roster.student(slot);
+                statusBar()->showMessage(QString("%1 %2 zaten yoklamada mevcut.").arg(student.firstName, student.lastName), 3000);
             }
+            return;
+        }
 
-            // Öğrencinin bu derse kayıtlı olup olmadığını kontrol et
-            if (dbManager.isStudentEnrolled(uid, courseId)) {
-                // Yoklamaya kaydet
-                int rowsAffected = 0;
-                if (dbManager.markStudentPresent(sessionId, student.id, rowsAffected)) {
-                    if (rowsAffected > 0) {
-                        showWelcomeNotification(student.firstName + " " + student.lastName);
-                        // Teacher widget'a yoklama listesini güncellemesi için sinyal gönder
-                        if (m_teacherWidget) {
-                            m_teacherWidget->updateAttendanceList();
-                        }
-                    } else {
-                         statusBar()->showMessage(QString("%1 %2 zaten yoklamada mevcut.").arg(student.firstName, student.lastName), 3000);
-                    }
-                } else {
-                    qWarning() << "Yoklama kaydedilemedi, öğrenci ID:" << student.id;
-                }
+        QElapsedTimer tapTimer;
+        tapTimer.start();
+
+        // Önce bellekteki oturum listesine bak; derse kayıtlı öğrenciler SQL okuması olmadan çözülür
+        CardTapResult tap;
+        int slot = m_roster.find(uid);
+        if (slot >= 0) {
+            tap.student = m_roster.student(slot);
+            if (m_roster.isPresent(slot)) {
+                tap.outcome = CardTapOutcome::AlreadyPresent;
             } else {
-                // Öğrenci derse kayıtlı değilse uyar
-                QMessageBox::warning(this, "Derse Kayıtlı Değil",
-                    QString("Öğrenci '%1 %2' bu derse kayıtlı değildir ve yoklamaya eklenemez.")
-                    .arg(student.firstName, student.lastName));
+                // Kayıt arka plan yazıcısına verilir; tekrar kontrolü listedeki bit ile yapılır
+                if (m_attendanceWriter->enqueue(sessionId, tap.student.id, uid)) {
+                    m_roster.markPresent(slot);
+                    tap.outcome = CardTapOutcome::PresentNew;
+                }
             }
         } else {
-            QMessageBox::warning(this, "Bilinmeyen Kart",
-                QString("Bu kart (%1) sistemde kayıtlı değil!\nÖğrenciyi önce sisteme eklemeniz gerekiyor.")
-                .arg(uid));
+            // Listede yok: bilinmeyen veya derse kayıtlı olmayan kart (nadir yol)
+            tap = dbManager.recordCardTap(sessionId, uid);
+            if (tap.outcome == CardTapOutcome::PresentNew || tap.outcome == CardTapOutcome::AlreadyPresent) {
+                // Liste eskimiş, öğrenciyi ekle
+                int newSlot = m_roster.addStudent(tap.student);
+                if (newSlot >= 0) {
+                    m_roster.markPresent(newSlot);
+                }
+            }
+        }
+        qint64 tapUs = tapTimer.nsecsElapsed() / 1000;
+        m_tapTiming.taps++;
+        m_tapTiming.totalUs += tapUs;
+        m_tapTiming.maxUs = qMax(m_tapTiming.maxUs, tapUs);
+
+        if (tap.outcome != CardTapOutcome::Error) {
+            m_recentTaps.insert(sessionId, uid, nowMs);
+        }
+
+        const Student& student = tap.student;
+        switch (tap.outcome) {
+        case CardTapOutcome::PresentNew:
+            m_cues->play(AudioCue::Present, detectedAtMs);
+            showWelcomeNotification(student);
+            // Tablolar yeniden yüklenmez, sadece yeni satır eklenir
+            emit attendanceRecorded({student.studentNumber, student.firstName, student.lastName,
+                                     QTime::currentTime().toString("HH:mm:ss")});
+            break;
+        case CardTapOutcome::AlreadyPresent:
+            m_cues->play(AudioCue::Duplicate, detectedAtMs);
+            statusBar()->showMessage(QString("%1 %2 zaten yoklamada mevcut.").arg(student.firstName, student.lastName), 3000);
+            break;
+        case CardTapOutcome::NotEnrolled:
+            // Öğrenci derse kayıtlı değilse uyar; modal pencere okumayı durdurmasın
+            m_cues->play(AudioCue::NotEnrolled, detectedAtMs);
+            m_notifications->post(NotificationKind::Warning, uid.toString(),
+                QString("%1 %2 bu derse kayıtlı değil").arg(student.firstName, student.lastName), 4000);
+            break;
+        case CardTapOutcome::UnknownCard:
+            m_cues->play(AudioCue::Unknown, detectedAtMs);
+            m_notifications->post(NotificationKind::Warning, uid.toString(),
+                QString("Bilinmeyen kart (%1)\nÖğrenciyi önce sisteme ekleyin").arg(uid.toString()), 4000);
+            break;
+        case CardTapOutcome::Error:
+            qWarning() << "Yoklama kaydedilemedi, kart UID:" << uid;
+            m_notifications->post(NotificationKind::Error, "tapError",
+                "Yoklama kaydedilemedi, kartı tekrar okutun", 4000);
+            break;
         }
     }
 }
 
-void MainWindow::showQuickAddDialog(const QString &cardUID, int courseId)
+void MainWindow::showQuickAddDialog(const CardUid &cardUID, int courseId)
 {
     QDialog* dialog = new QDialog(this);
     dialog->setWindowTitle("Yeni Öğrenci Ekle");
@@ -435,7 +454,7 @@ void MainWindow::showQuickAddDialog(const QString &cardUID, int courseId)
     
     QVBoxLayout* layout = new QVBoxLayout(dialog);
     
-    QLabel* infoLabel = new QLabel(QString("Kart UID: %1").arg(cardUID));
+    QLabel* infoLabel = new QLabel(QString("Kart UID: %1").arg(cardUID.toString()));
     infoLabel->setStyleSheet("font-weight: bold;");
     layout->addWidget(infoLabel);
     
@@ -485,9 +504,15 @@ void MainWindow::showQuickAddDialog(const QString &cardUID, int courseId)
                 cardUID, studentNumber, firstName, lastName, currentUser.id, courseId);
             
             if (newStudent.id > 0) {
+                onStudentEnrolled(courseId, newStudent);
+
                 // Öğrenciyi yoklamaya ekle
                 int rowsAffected;
                 if (dbManager.markStudentPresent(m_currentAttendanceSessionId, newStudent.id, rowsAffected)) {
+                    int slot = m_roster.find(newStudent.cardUID);
+                    if (slot >= 0) {
+                        m_roster.markPresent(slot);
+                    }
                     QMessageBox::information(dialog, "Başarılı", 
                         QString("Öğrenci başarıyla eklendi ve yoklamaya kaydedildi:\n%1 %2 (%3)")
                         .arg(newStudent.firstName, newStudent.lastName, newStudent.studentNumber));
@@ -541,6 +566,7 @@ void MainWindow::showQuickEnrollDialog(const Student &student, int courseId)
     
     connect(enrollButton, &QPushButton::clicked, [this, dialog, student, courseId]() {
         if (dbManager.enrollStudentToCourse(student.id, courseId, currentUser.id)) {
+            onStudentEnrolled(courseId, student);
             QMessageBox::information(dialog, "Başarılı", 
                 QString("Öğrenci %1 %2 derse kaydedildi.").arg(student.firstName, student.lastName));
             dialog->accept();
@@ -567,78 +593,16 @@ void MainWindow::showQuickEnrollDialog(const Student &student, int courseId)
     dialog->show();
 }
 
-quint8 MainWindow::calculateLRC(const QByteArray &data)
-{
-    quint8 lrc = 0;
-    for (char byte : data) {
-        lrc ^= byte;
-    }
-    return lrc;
-}
-
-QByteArray MainWindow::createPollPacket()
-{
-    // Başarılı testlerdeki çalışan komut yapısı:
-    // STX | LEN | PCB | INS | DATA... | LRC | ETX
-    // 02  | 0A  | 00  | 3E  | DF7E0100| 96  | 03
-
-    QByteArray data;
-    data.append(static_cast<char>(0xDF));
-    data.append(static_cast<char>(0x7E));
-    data.append(static_cast<char>(0x01));
-    data.append(static_cast<char>(0x00));
-
-    // LRC ve ETX hariç paketi oluştur
-    QByteArray packet;
-    packet.append(static_cast<char>(STX));                                 // STX
-    packet.append(static_cast<char>(data.length() + 6)); // LEN: PCB,INS,DATA,LRC,ETX + STX = 6
-    packet.append(static_cast<char>(PCB));              // PCB
-    packet.append(INS_DO);                              // INS
-    packet.append(data);                                // DATA
-
-    // LRC'yi PCB'den itibaren hesapla
-    packet.append(calculateLRC(packet.mid(2)));      // LRC
-    packet.append(ETX);                                 // ETX
-    
-    // PDF'e göre LEN, STX ve ETX hariç geri kalan her şeyin uzunluğu.
-    // PCB(1) + INS(1) + DATA(4) + LRC(1) = 7
-    // Bu yüzden LEN'i 7 yapalım.
-    packet[1] = static_cast<char>(data.length() + 3); // PCB+INS+LRC = 3
-    
-    // LRC'yi de yeni uzunluğa göre yeniden hesapla
-    packet[packet.size() - 2] = calculateLRC(packet.mid(2, packet.size() - 4));
-
-
-    // Çalışan komut: 02 0A 00 3E DF 7E 01 00 96 03
-    // Bu komutta LEN=10, yani tüm paketin uzunluğu. LRC, STX dahil geri kalan her şeyin XOR'u.
-    // Bunu deneyelim.
-    
-    QByteArray finalPacket;
-    finalPacket.append(STX); // 0x02
-    quint8 totalLength = 1 + 1 + 1 + 1 + data.length() + 1 + 1; // STX+LEN+PCB+INS+DATA+LRC+ETX
-    finalPacket.append(static_cast<char>(totalLength)); // LEN = 0x0A
-    finalPacket.append(static_cast<char>(PCB)); // PCB = 0x00
-    finalPacket.append(INS_DO); // INS = 0x3E
-    finalPacket.append(data);   // DATA = DF 7E 01 00
-
-    // LRC, STX'ten itibaren tüm baytların XOR'u
-    finalPacket.append(calculateLRC(finalPacket));
-    finalPacket.append(ETX);
-
-    return finalPacket;
-}
-
 void MainWindow::teacherCardScanRequested()
 {
     // Kart okuma modunu aktifleştir
     m_isCardScanModeActive = true;
     
     // Kart okuma başlat
-    if (m_serialPort->isOpen() && !m_pollTimer->isActive()) {
+    if (m_readerPool && m_readerPool->hasOpenReader() && !m_readerPool->isPolling()) {
         // Tek seferlik kart okuma
-        QByteArray pollPacket = createPollPacket();
         qDebug() << "Öğrenci ekleme için kart okuma başlatıldı";
-        m_serialPort->write(pollPacket);
+        m_readerPool->pollOnce();
         
         // Kart okuma modunu 10 saniye sonra otomatik kapat
         QTimer::singleShot(10000, this, [this]() {
@@ -652,29 +616,17 @@ void MainWindow::teacherCardScanRequested()
     }
 }
 
-void MainWindow::readSerialData()
-{
-    // Bu fonksiyon, onSerialPortReadyRead fonksiyonunun yerine kullanılacak
-    // veya ihtiyaç duyulursa buraya kod eklenebilir
-    if (m_serialPort && m_serialPort->isOpen()) {
-        m_readBuffer.append(m_serialPort->readAll());
-        
-        // STX ve ETX arasındaki veriyi işle
-        if (m_readBuffer.startsWith(STX) && m_readBuffer.endsWith(ETX)) {
-            qDebug() << "Tam bir paket alındı:" << m_readBuffer.toHex(' ').toUpper();
-            processCardResponse(m_readBuffer);
-            m_readBuffer.clear();
-        } else {
-            qDebug() << "Kısmi veri alındı, bekleniyor:" << m_readBuffer.toHex(' ').toUpper();
-        }
-    }
-}
-
 void MainWindow::onAttendanceStarted(int sessionId)
 {
     qDebug() << "Yoklama başlatıldı, session ID:" << sessionId;
     m_currentAttendanceSessionId = sessionId;
     m_isAttendanceActive = true;
+    m_tapTiming = TapTimingStats();
+
+    // Oturumun ders listesini belleğe al
+    int courseId = dbManager.getCourseIdForSession(sessionId);
+    m_roster.build(sessionId, courseId, dbManager.getSessionRoster(sessionId));
+
     startCardPolling();
     statusBar()->showMessage(QString("Yoklama aktif. Session ID: %1").arg(sessionId), 5000);
 }
@@ -683,47 +635,83 @@ void MainWindow::onAttendanceEnded()
 {
     qDebug() << "Yoklama sonlandırıldı.";
     m_isAttendanceActive = false;
+    // Bekleyen kayıtları yaz ki geçmiş doğru sayılarla yüklensin
+    m_attendanceWriter->flush();
+    m_roster.clear();
+    AttendanceWriterStats writer = m_attendanceWriter->stats();
+    TapJournalStats journal = m_attendanceWriter->journalStats();
+    qDebug() << "Yoklama yazıcısı - kayıt:" << writer.committedRecords << "kuyruk en fazla:" << writer.maxQueueDepth
+             << "| commit:" << writer.commitCount << "en uzun:" << writer.maxCommitUs << "µs"
+             << "tekrar denenen:" << writer.retriedCommits << "yazılamayan kayıt:" << writer.failedRecords
+             << "| günlük:" << journal.appends << "kayıt," << qRound64(journal.appendsPerSecond()) << "kayıt/s"
+             << "en uzun:" << journal.maxAppendNs << "ns";
+    qDebug() << "Kart işleme süresi - okuma:" << m_tapTiming.taps << "ort:" << m_tapTiming.averageUs()
+             << "µs en fazla:" << m_tapTiming.maxUs << "µs";
+    qDebug() << "Tekrar okuma önbelleği - isabet:" << m_recentTaps.hits() << "ıska:" << m_recentTaps.misses();
+    const NotificationQueueStats& notices = m_notifications->stats();
+    qDebug() << "Bildirimler - gönderilen:" << notices.posted << "gösterilen:" << notices.shown
+             << "birleştirilen:" << notices.coalesced << "atılan:" << notices.dropped
+             << "en fazla bekleyen:" << notices.maxPending;
+    const AudioCueStats& cues = m_cues->stats();
+    qDebug() << "Ses ipuçları - istenen:" << cues.requested << "başlayan:" << cues.started
+             << "baştan başlatılan:" << cues.restarted
+             << "| UID çözme-ses başlangıcı ort:" << cues.averageDecodeToStartMs() << "ms en fazla:"
+             << cues.maxDecodeToStartMs << "ms";
+    m_notifications->clear();
+    m_recentTaps.clear();
     stopCardPolling();
     statusBar()->showMessage("Yoklama sona erdi.", 5000);
 }
 
+void MainWindow::onStudentEnrolled(int courseId, const Student& student)
+{
+    // Derse kayıtlı değil diye önbelleğe alınmış okumalar artık geçersiz
+    m_recentTaps.clear();
+
+    // Aktif oturumun dersine eklenen öğrenciyi bellekteki listeye işle
+    if (m_roster.isValid() && m_roster.courseId() == courseId) {
+        m_roster.addStudent(student);
+        qDebug() << "Oturum listesine öğrenci eklendi:" << student.studentNumber;
+    }
+}
+
+void MainWindow::onAttendanceRecordFailed(int sessionId, int studentId, const QString& error)
+{
+    qWarning() << "Yoklama kaydı yazılamadı, oturum:" << sessionId << "öğrenci:" << studentId << error;
+
+    // Okutma anında "var" sayılmıştı; bit geri alınır ki tekrar okutma yeni kayıt olarak işlensin
+    QString name = QString::number(studentId);
+    if (m_roster.isValid() && m_roster.sessionId() == sessionId) {
+        int slot = m_roster.findStudent(studentId);
+        if (slot >= 0) {
+            const Student& student = m_roster.student(slot);
+            name = student.firstName + " " + student.lastName;
+            m_roster.clearPresent(slot);
+            m_recentTaps.remove(sessionId, student.cardUID);
+        }
+    }
+
+    m_notifications->post(NotificationKind::Error, "writeFailed_" + QString::number(studentId),
+        QString("%1 yoklamaya yazılamadı, kartı tekrar okutun").arg(name), 8000);
+
+    // Tablolara eklenmiş satırlar veritabanındaki duruma göre düzeltilir
+    if (m_teacherWidget && sessionId == m_currentAttendanceSessionId) {
+        m_teacherWidget->updateAttendanceList();
+    }
+}
+
 void MainWindow::onCardDetected(const QString& uid)
 {
     // Bu fonksiyon, kart algılandığında çağrılabilir
-    // Şu anda processCardResponse içinde doğrudan işlem yapıyoruz
+    // Şu anda handleCardUid içinde doğrudan işlem yapıyoruz
     // İhtiyaç duyulursa buraya kod eklenebilir
     qDebug() << "Kart algılandı, UID:" << uid;
 }
 
-void MainWindow::showWelcomeNotification(const QString &studentName)
+void MainWindow::showWelcomeNotification(const Student& student)
 {
-    // Sesi çal
-    if (m_successSound->playbackState() == QMediaPlayer::PlayingState) {
-        m_successSound->setPosition(0);
-    }
-    m_successSound->play();
-
-    // Görsel bildirim
-    QLabel* notificationLabel = new QLabel(QString("Hoş Geldin, %1!").arg(studentName), this);
-    notificationLabel->setObjectName("notificationLabel");
-    notificationLabel->setAlignment(Qt::AlignCenter);
-    
-    // Stil ayarları
-    notificationLabel->setStyleSheet(
-        "QLabel#notificationLabel {"
-        "  background-color: rgba(46, 204, 113, 0.9);"
-        "  color: white;"
-        "  font-size: 24pt;"
-        "  font-weight: bold;"
-        "  padding: 20px;"
-        "  border-radius: 15px;"
-        "}"
-    );
-
-    notificationLabel->adjustSize();
-    notificationLabel->move((this->width() - notificationLabel->width()) / 2, (this->height() - notificationLabel->height()) / 2);
-    notificationLabel->show();
-
-    // 2 saniye sonra etiketi yok et
-    QTimer::singleShot(2000, notificationLabel, &QLabel::deleteLater);
+    // Görsel bildirim; art arda gelen öğrenciler alt alta sıralanır.
+    // Anahtar öğrenci ID'si: aynı adlı iki öğrenci tek bildirimde birleşmez.
+    m_notifications->post(NotificationKind::Welcome, "welcome_" + QString::number(student.id),
+        QString("Hoş Geldin, %1 %2!").arg(student.firstName, student.lastName));
 }
@@ -12,22 +12,26 @@
 #include <QStackedWidget>
 #include <QStatusBar>
 #include <QLabel>
-#include <QtMultimedia/QMediaPlayer>
-#include <QtMultimedia/QAudioOutput>
 #include "databasemanager.h"
 #include "loginwidget.h"
 #include "adminwidget.h"
 #include "teacherwidget.h"
 #include "studentwidget.h"
+#include "sessionroster.h"
+#include "attendancewriter.h"
+#include "cardreaderpool.h"
+#include "recenttapcache.h"
+#include "notificationqueue.h"
+#include "audiocuebank.h"
 
-// Protokol sabitleri
-#define STX 0x02
-#define ETX 0x03
-#define PCB 0x00
-#define INS_DO 0x3E
-#define INS_SET 0x3C
-#define INS_GET 0x3D
-#define INS_NAK 0x15
+// Bir yoklama oturumunda kart okumalarının işlenme süreleri (oturum sonunda bir kez yazılır)
+struct TapTimingStats {
+    qint64 taps = 0;
+    qint64 totalUs = 0;
+    qint64 maxUs = 0;
+
+    qint64 averageUs() const { return taps > 0 ? totalUs / taps : 0; }
+};
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
@@ -43,15 +47,18 @@ public:
 
 signals:
     void cardScanned(const QString& uid);
+    void attendanceRecorded(const AttendanceRecord& record);
 
 private slots:
     void onLoginSuccessful(const User& user);
     void onLogoutRequested();
-    void readSerialData();
     void onAttendanceStarted(int sessionId);
     void onAttendanceEnded();
     void onCardDetected(const QString& uid);
     void teacherCardScanRequested();
+    void onStudentEnrolled(int courseId, const Student& student);
+    void onAttendanceRecordFailed(int sessionId, int studentId, const QString& error);
+    void handleCardUid(const CardUid &uid, int readerIndex, qint64 detectedAtMs);
 
 private:
     void setupUI();
@@ -59,15 +66,10 @@ private:
     void setupCardReader();
     void startCardPolling();
     void stopCardPolling();
-    void pollCard();
-    void onSerialPortReadyRead();
-    void processCardResponse(const QByteArray &response);
-    void processUid(const QString &uid, int sessionId);
-    void showQuickAddDialog(const QString &cardUID, int courseId);
+    void processUid(const CardUid &uid, int sessionId, qint64 detectedAtMs);
+    void showQuickAddDialog(const CardUid &cardUID, int courseId);
     void showQuickEnrollDialog(const Student &student, int courseId);
-    void showWelcomeNotification(const QString& studentName);
-    quint8 calculateLRC(const QByteArray &data);
-    QByteArray createPollPacket();
+    void showWelcomeNotification(const Student& student);
     void setupSerialPort();
     void setupConnections();
     void debugDatabaseTables();
@@ -77,8 +79,8 @@ private:
     
     // Modüler widget'lar
     LoginWidget* m_loginWidget;
-    AdminWidget* m_adminWidget;
-    TeacherWidget* m_teacherWidget;
+    AdminWidget* m_adminWidget = nullptr;
+    TeacherWidget* m_teacherWidget = nullptr;
     StudentWidget* m_studentWidget = nullptr;
     QStackedWidget* m_stackedWidget;
     
@@ -87,16 +89,18 @@ private:
     bool m_doubleClickProcessed = false;
     
     // Kart Okuyucu Donanımı
-    QSerialPort *m_serialPort;
-    QTimer *m_pollTimer;
+    CardReaderPool* m_readerPool = nullptr;
     QTimer *m_doubleClickTimer;
-    QByteArray m_readBuffer;
     QLabel *m_statusLabel;
-    QMediaPlayer* m_successSound;
-    QAudioOutput* m_audioOutput;
+    AudioCueBank* m_cues = nullptr;
+    NotificationQueue* m_notifications = nullptr;
     
     int m_currentAttendanceSessionId;
     bool m_isAttendanceActive;
+    SessionRoster m_roster;
+    RecentTapCache m_recentTaps;
+    TapTimingStats m_tapTiming;
+    AttendanceWriter* m_attendanceWriter = nullptr;
     bool m_isCardScanModeActive;
 };
 
@@ -0,0 +1,177 @@
+#include "notificationqueue.h"
+#include <QWidget>
+#include <QLabel>
+#include <QTimer>
+#include <QEvent>
+
+namespace {
+const int kSpacing = 10;
+}
+
+NotificationQueue::NotificationQueue(QWidget* host)
+    : QObject(host)
+    , m_host(host)
+{
+    m_host->installEventFilter(this);
+}
+
+bool NotificationQueue::eventFilter(QObject* watched, QEvent* event)
+{
+    if (watched == m_host && event->type() == QEvent::Resize) {
+        layoutVisible();
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void NotificationQueue::post(NotificationKind kind, const QString& key, const QString& text, int durationMs)
+{
+    m_stats.posted++;
+
+    if (!key.isEmpty()) {
+        // Görünen bildirimle birleşirse metni güncellenir ve süresi yeniden başlar
+        for (Notification& notification : m_visible) {
+            if (notification.kind == kind && notification.key == key) {
+                notification.text = text;
+                notification.repeatCount++;
+                notification.label->setText(displayText(notification));
+                notification.label->adjustSize();
+                notification.timer->start(durationMs);
+                m_stats.coalesced++;
+                layoutVisible();
+                return;
+            }
+        }
+        for (Notification& notification : m_pending) {
+            if (notification.kind == kind && notification.key == key) {
+                notification.text = text;
+                notification.repeatCount++;
+                notification.durationMs = durationMs;
+                m_stats.coalesced++;
+                return;
+            }
+        }
+    }
+
+    // Aynı öncelikteki bildirimler geliş sırasını korur
+    int position = m_pending.count();
+    while (position > 0 && m_pending.at(position - 1).kind > kind) {
+        --position;
+    }
+    m_pending.insert(position, Notification{kind, key, text, durationMs});
+
+    if (m_pending.count() > kMaxPending) {
+        // En düşük öncelikli, en yeni bildirim atılır
+        m_pending.removeLast();
+        m_stats.dropped++;
+    }
+    m_stats.maxPending = qMax(m_stats.maxPending, m_pending.count());
+
+    showNext();
+}
+
+void NotificationQueue::clear()
+{
+    for (const Notification& notification : m_visible) {
+        notification.timer->stop();
+        notification.label->deleteLater();
+    }
+    m_visible.clear();
+    m_pending.clear();
+}
+
+void NotificationQueue::showNext()
+{
+    while (!m_pending.isEmpty() && m_visible.count() < kMaxVisible) {
+        Notification notification = m_pending.takeFirst();
+
+        QLabel* label = new QLabel(displayText(notification), m_host);
+        label->setObjectName("notificationLabel");
+        label->setAlignment(Qt::AlignCenter);
+        label->setStyleSheet(styleSheetFor(notification.kind));
+        label->setAttribute(Qt::WA_TransparentForMouseEvents);
+        label->adjustSize();
+        label->show();
+
+        // Zamanlayıcı etiketle birlikte silinir
+        QTimer* timer = new QTimer(label);
+        timer->setSingleShot(true);
+        connect(timer, &QTimer::timeout, this, [this, label]() { hide(label); });
+        timer->start(notification.durationMs);
+
+        notification.label = label;
+        notification.timer = timer;
+        m_visible.append(notification);
+        m_stats.shown++;
+    }
+    layoutVisible();
+}
+
+void NotificationQueue::hide(QLabel* label)
+{
+    for (int i = 0; i < m_visible.count(); ++i) {
+        if (m_visible.at(i).label == label) {
+            m_visible.removeAt(i);
+            break;
+        }
+    }
+    label->deleteLater();
+
+    layoutVisible();
+    showNext();
+}
+
+void NotificationQueue::layoutVisible()
+{
+    // Bildirimler pencerenin ortasında alt alta dizilir
+    int totalHeight = 0;
+    for (const Notification& notification : m_visible) {
+        totalHeight += notification.label->height() + kSpacing;
+    }
+
+    int y = (m_host->height() - totalHeight + kSpacing) / 2;
+    for (const Notification& notification : m_visible) {
+        QLabel* label = notification.label;
+        label->move((m_host->width() - label->width()) / 2, y);
+        label->raise();
+        y += label->height() + kSpacing;
+    }
+}
+
+QString NotificationQueue::displayText(const Notification& notification)
+{
+    if (notification.repeatCount > 1) {
+        return QString("%1 (x%2)").arg(notification.text).arg(notification.repeatCount);
+    }
+    return notification.text;
+}
+
+QString NotificationQueue::styleSheetFor(NotificationKind kind)
+{
+    QString background;
+    QString fontSize = "16pt";
+    switch (kind) {
+    case NotificationKind::Welcome:
+        background = "rgba(46, 204, 113, 0.9)";
+        fontSize = "24pt";
+        break;
+    case NotificationKind::Info:
+        background = "rgba(52, 152, 219, 0.9)";
+        break;
+    case NotificationKind::Warning:
+        background = "rgba(230, 126, 34, 0.95)";
+        break;
+    case NotificationKind::Error:
+        background = "rgba(231, 76, 60, 0.95)";
+        break;
+    }
+
+    return QString(
+        "QLabel#notificationLabel {"
+        "  background-color: %1;"
+        "  color: white;"
+        "  font-size: %2;"
+        "  font-weight: bold;"
+        "  padding: 20px;"
+        "  border-radius: 15px;"
+        "}").arg(background, fontSize);
+}
@@ -0,0 +1,79 @@
+#ifndef NOTIFICATIONQUEUE_H
+#define NOTIFICATIONQUEUE_H
+
+#include <QObject>
+#include <QVector>
+#include <QString>
+
+class QWidget;
+class QLabel;
+class QTimer;
+
+// Öncelik sırasıyla: önce hatalar, en son karşılama mesajları gösterilir
+enum class NotificationKind {
+    Error,
+    Warning,
+    Info,
+    Welcome
+};
+
+struct NotificationQueueStats {
+    qint64 posted = 0;
+    qint64 shown = 0;
+    qint64 coalesced = 0;  // Aynı anahtarlı bildirimle birleştirilenler
+    qint64 dropped = 0;    // Kuyruk dolduğu için atılan düşük öncelikliler
+    int maxPending = 0;
+};
+
+// Ana pencerenin üzerinde modal olmayan bildirimler (toast) gösteren kuyruk.
+// QMessageBox gibi iç içe olay döngüsü açmaz; kart okutma işlenmeye devam eder.
+// Aynı anahtarlı bildirimler (ör. aynı kartın tekrar okutulması) tek bildirimde birleşip
+// süresi yenilenir; aynı anda en fazla kMaxVisible bildirim görünür, kalanlar öncelik
+// sırasıyla bekler.
+class NotificationQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kMaxVisible = 3;
+    static constexpr int kMaxPending = 32;
+
+    explicit NotificationQueue(QWidget* host);
+
+    // key boşsa birleştirme yapılmaz
+    void post(NotificationKind kind, const QString& key, const QString& text, int durationMs = 2000);
+    void clear();
+
+    int visibleCount() const { return m_visible.count(); }
+    int pendingCount() const { return m_pending.count(); }
+    const NotificationQueueStats& stats() const { return m_stats; }
+
+protected:
+    // Ana pencere yeniden boyutlandığında bildirimler ortada kalsın
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    struct Notification {
+        NotificationKind kind;
+        QString key;
+        QString text;
+        int durationMs;
+        int repeatCount = 1;
+        QLabel* label = nullptr;
+        QTimer* timer = nullptr;
+    };
+
+    static QString displayText(const Notification& notification);
+    static QString styleSheetFor(NotificationKind kind);
+
+    void showNext();
+    void hide(QLabel* label);
+    void layoutVisible();
+
+    QWidget* m_host;
+    QVector<Notification> m_visible;
+    QVector<Notification> m_pending; // Öncelik, sonra geliş sırasına göre dizili
+    NotificationQueueStats m_stats;
+};
+
+#endif // NOTIFICATIONQUEUE_H
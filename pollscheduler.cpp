@@ -0,0 +1,60 @@
+#include "pollscheduler.h"
+
+PollScheduler::PollScheduler(int minIntervalMs, int maxIntervalMs, int fastPollsAfterCard)
+    : m_minIntervalMs(1)
+    , m_maxIntervalMs(1)
+    , m_fastPollsAfterCard(qMax(0, fastPollsAfterCard))
+    , m_intervalMs(1)
+    , m_emptySinceCard(0)
+{
+    setLimits(minIntervalMs, maxIntervalMs);
+}
+
+void PollScheduler::setLimits(int minIntervalMs, int maxIntervalMs)
+{
+    m_minIntervalMs = qMax(1, minIntervalMs);
+    m_maxIntervalMs = qMax(m_minIntervalMs, maxIntervalMs);
+    m_intervalMs = qBound(m_minIntervalMs, m_intervalMs, m_maxIntervalMs);
+}
+
+void PollScheduler::reset()
+{
+    m_intervalMs = m_minIntervalMs;
+    m_emptySinceCard = 0;
+}
+
+void PollScheduler::recordPollSent()
+{
+    m_stats.polls++;
+}
+
+void PollScheduler::recordCard(qint64 latencyUs)
+{
+    m_stats.cards++;
+    m_stats.lastLatencyUs = latencyUs;
+    m_stats.maxLatencyUs = qMax(m_stats.maxLatencyUs, latencyUs);
+    m_stats.totalLatencyUs += latencyUs;
+
+    // Kartlar geliyor: sıradaki öğrenci için hızlı yokla
+    m_intervalMs = m_minIntervalMs;
+    m_emptySinceCard = 0;
+}
+
+void PollScheduler::recordEmpty()
+{
+    m_stats.emptyResponses++;
+    backOff();
+}
+
+void PollScheduler::recordTimeout()
+{
+    m_stats.timeouts++;
+    backOff();
+}
+
+void PollScheduler::backOff()
+{
+    // Son karttan sonra kısa bir süre daha hızlı kal, sonra aralığı katla
+    if (++m_emptySinceCard <= m_fastPollsAfterCard) return;
+    m_intervalMs = qMin(m_intervalMs * 2, m_maxIntervalMs);
+}
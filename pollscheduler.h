@@ -0,0 +1,53 @@
+#ifndef POLLSCHEDULER_H
+#define POLLSCHEDULER_H
+
+#include <QtGlobal>
+
+struct PollSchedulerStats {
+    qint64 polls = 0;
+    qint64 cards = 0;
+    qint64 emptyResponses = 0;
+    qint64 timeouts = 0;
+    qint64 lastLatencyUs = 0;   // Yoklama komutundan UID'li yanıta kadar geçen süre
+    qint64 maxLatencyUs = 0;
+    qint64 totalLatencyUs = 0;
+
+    double pollsPerCard() const { return cards > 0 ? double(polls) / cards : 0.0; }
+    qint64 averageLatencyUs() const { return cards > 0 ? totalLatencyUs / cards : 0; }
+};
+
+// Kart okuyucu yoklama aralığını belirleyen sınıf.
+// Kart okundukça en kısa aralıkla yoklar; belli sayıda boş yanıttan sonra
+// aralığı her boş yanıtta iki katına çıkararak en uzun aralığa kadar geri çekilir.
+class PollScheduler
+{
+public:
+    explicit PollScheduler(int minIntervalMs = 50, int maxIntervalMs = 1000, int fastPollsAfterCard = 40);
+
+    void setLimits(int minIntervalMs, int maxIntervalMs);
+    int minIntervalMs() const { return m_minIntervalMs; }
+    int maxIntervalMs() const { return m_maxIntervalMs; }
+
+    // Yoklama başlarken kart bekleniyor kabul edilir, en kısa aralıkla başlanır
+    void reset();
+
+    void recordPollSent();
+    void recordCard(qint64 latencyUs);
+    void recordEmpty();
+    void recordTimeout();
+
+    int nextIntervalMs() const { return m_intervalMs; }
+    const PollSchedulerStats& stats() const { return m_stats; }
+
+private:
+    void backOff();
+
+    int m_minIntervalMs;
+    int m_maxIntervalMs;
+    int m_fastPollsAfterCard;
+    int m_intervalMs;
+    int m_emptySinceCard;
+    PollSchedulerStats m_stats;
+};
+
+#endif // POLLSCHEDULER_H
@@ -0,0 +1,377 @@
+#include "readersimulator.h"
+#include "cardreaderworker.h"
+#include <QSocketNotifier>
+#include <QTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QRandomGenerator>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace {
+const char* const kSimulatorConnectionName = "yoklama_simulator_connection";
+
+qint64 percentile(const QVector<qint64>& sorted, double p)
+{
+    if (sorted.isEmpty()) return 0;
+    int rank = static_cast<int>(std::ceil(p * sorted.count()));
+    return sorted.at(qBound(0, rank - 1, sorted.count() - 1));
+}
+}
+
+ReaderSimulator::ReaderSimulator(QObject* parent)
+    : QObject(parent)
+    , m_masterFd(-1)
+    , m_slaveFd(-1)
+    , m_notifier(nullptr)
+    , m_tickTimer(new QTimer(this))
+    , m_recordTimer(new QTimer(this))
+    , m_pollPacket(CardReaderWorker::createPollPacket())
+    , m_lastRecordId(0)
+    , m_nextTap(0)
+    , m_cardPresent(false)
+    , m_cardServed(false)
+    , m_cardRemoveAtMs(0)
+    , m_dwellMs(300)
+    , m_recordTimeoutMs(5000)
+{
+    m_tickTimer->setTimerType(Qt::PreciseTimer);
+    m_tickTimer->setInterval(kTickMs);
+    connect(m_tickTimer, &QTimer::timeout, this, &ReaderSimulator::onTick);
+    m_recordTimer->setTimerType(Qt::PreciseTimer);
+    m_recordTimer->setInterval(kRecordCheckMs);
+    connect(m_recordTimer, &QTimer::timeout, this, &ReaderSimulator::onRecordCheck);
+}
+
+ReaderSimulator::~ReaderSimulator()
+{
+    delete m_notifier;
+    if (m_slaveFd >= 0) ::close(m_slaveFd);
+    if (m_masterFd >= 0) ::close(m_masterFd);
+
+    if (m_db.isOpen()) m_db.close();
+    m_db = QSqlDatabase();
+    QSqlDatabase::removeDatabase(kSimulatorConnectionName);
+}
+
+QString ReaderSimulator::openTerminal()
+{
+    m_masterFd = ::posix_openpt(O_RDWR | O_NOCTTY);
+    if (m_masterFd < 0 || ::grantpt(m_masterFd) != 0 || ::unlockpt(m_masterFd) != 0) {
+        qDebug() << "Pseudo-terminal açılamadı:" << strerror(errno);
+        return QString();
+    }
+    QString slavePath = QString::fromLocal8Bit(::ptsname(m_masterFd));
+
+    m_slaveFd = ::open(slavePath.toLocal8Bit().constData(), O_RDWR | O_NOCTTY);
+    if (m_slaveFd < 0) {
+        qDebug() << "Pseudo-terminal ucu açılamadı:" << slavePath << strerror(errno);
+        return QString();
+    }
+    // Yankı ve satır düzenleme kapalı; aksi halde yoklama paketleri uygulamaya geri döner
+    termios options;
+    ::tcgetattr(m_slaveFd, &options);
+    ::cfmakeraw(&options);
+    ::tcsetattr(m_slaveFd, TCSANOW, &options);
+
+    ::fcntl(m_masterFd, F_SETFL, ::fcntl(m_masterFd, F_GETFL) | O_NONBLOCK);
+    m_notifier = new QSocketNotifier(m_masterFd, QSocketNotifier::Read);
+    connect(m_notifier, &QSocketNotifier::activated, this, &ReaderSimulator::onTerminalReadable);
+    m_tickTimer->start();
+    m_recordTimer->start();
+    return slavePath;
+}
+
+bool ReaderSimulator::openDatabase(const QString& path)
+{
+    m_db = QSqlDatabase::addDatabase("QSQLITE", kSimulatorConnectionName);
+    m_db.setDatabaseName(path);
+    if (!m_db.open()) {
+        qDebug() << "Veritabanı açılamadı:" << m_db.lastError().text();
+        return false;
+    }
+
+    // Sadece simülasyon sırasında eklenen kayıtlar izlenir
+    QSqlQuery query(m_db);
+    if (!query.exec("SELECT COALESCE(MAX(id), 0) FROM attendanceRecords") || !query.next()) {
+        qDebug() << "Yoklama kayıtları okunamadı:" << query.lastError().text();
+        return false;
+    }
+    m_lastRecordId = query.value(0).toLongLong();
+
+    // Aktif oturumda zaten kaydı olan öğrencilerden yeni satır beklenmez
+    if (!query.exec("SELECT r.studentId FROM attendanceRecords r "
+                    "JOIN attendance_sessions a ON a.id = r.sessionId WHERE a.is_active = 1")) {
+        qDebug() << "Oturum kayıtları okunamadı:" << query.lastError().text();
+        return false;
+    }
+    while (query.next()) {
+        m_recordedStudents.insert(query.value(0).toInt());
+    }
+    return true;
+}
+
+bool ReaderSimulator::loadScript(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qDebug() << "Betik açılamadı:" << path << file.errorString();
+        return false;
+    }
+
+    m_taps.clear();
+    int lineNumber = 0;
+    while (!file.atEnd()) {
+        lineNumber++;
+        QString line = QString::fromUtf8(file.readLine()).trimmed();
+        if (line.isEmpty() || line.startsWith('#')) continue;
+
+        int separator = line.indexOf(' ');
+        bool ok = false;
+        qint64 atMs = line.left(separator).toLongLong(&ok);
+        CardUid uid = CardUid::fromString(line.mid(separator + 1));
+        if (separator < 0 || !ok || !uid.isValid()) {
+            qDebug() << "Betik satırı geçersiz:" << lineNumber << line;
+            return false;
+        }
+        m_taps.append({atMs, uid});
+    }
+
+    std::stable_sort(m_taps.begin(), m_taps.end(), [](const SimulatedTap& a, const SimulatedTap& b) {
+        return a.atMs < b.atMs;
+    });
+    return !m_taps.isEmpty();
+}
+
+bool ReaderSimulator::generateRandom(int count, double tapsPerSecond, double unknownRatio)
+{
+    QSqlQuery query(m_db);
+    if (!query.exec("SELECT s.cardUID FROM attendance_sessions a "
+                    "JOIN enrollments e ON e.courseId = a.course_id "
+                    "JOIN students s ON s.id = e.studentId "
+                    "WHERE a.is_active = 1 AND NOT EXISTS "
+                    "(SELECT 1 FROM attendanceRecords r WHERE r.sessionId = a.id AND r.studentId = s.id)")) {
+        qDebug() << "Oturum öğrencileri okunamadı:" << query.lastError().text();
+        return false;
+    }
+
+    QVector<CardUid> uids;
+    while (query.next()) {
+        CardUid uid = CardUid::fromByteArray(query.value(0).toByteArray());
+        if (uid.isValid()) uids.append(uid);
+    }
+    if (uids.isEmpty()) {
+        qDebug() << "Aktif oturum yok ya da tüm öğrencilerin yoklaması alınmış";
+        return false;
+    }
+
+    m_taps.clear();
+    QRandomGenerator* random = QRandomGenerator::global();
+    double atMs = 0;
+    for (int i = 0; i < count; ++i) {
+        // Poisson geliş: aralıklar üstel dağılımlı
+        atMs += -std::log(1.0 - random->generateDouble()) * 1000.0 / tapsPerSecond;
+        CardUid uid;
+        if (random->generateDouble() < unknownRatio) {
+            // 08 ile başlayan 4 baytlık rastgele UID: kayıtlı kartlarla çakışmaz
+            quint32 value = 0x08000000u | (random->generate() & 0x00FFFFFFu);
+            char bytes[4] = {char(value >> 24), char(value >> 16), char(value >> 8), char(value)};
+            uid = CardUid::fromBytes(bytes, sizeof(bytes));
+        } else {
+            uid = uids.at(random->bounded(uids.count()));
+        }
+        m_taps.append({static_cast<qint64>(atMs), uid});
+    }
+    return true;
+}
+
+void ReaderSimulator::onTerminalReadable()
+{
+    char buffer[256];
+    ssize_t size;
+    while ((size = ::read(m_masterFd, buffer, sizeof(buffer))) > 0) {
+        const char* bytes = buffer;
+        int remaining = static_cast<int>(size);
+        while (remaining > 0) {
+            int accepted = m_decoder.feed(bytes, remaining);
+            bytes += accepted;
+            remaining -= accepted;
+
+            QByteArray frame;
+            while (m_decoder.nextFrame(frame)) {
+                handleFrame(frame);
+            }
+        }
+    }
+}
+
+void ReaderSimulator::handleFrame(const QByteArray& frame)
+{
+    if (frame != m_pollPacket) {
+        m_report.badFrames++;
+        return;
+    }
+
+    if (!m_clock.isValid()) {
+        // Okutma zamanları uygulama yoklamaya başladığında işlemeye başlar
+        m_clock.start();
+        qDebug() << "İlk yoklama paketi alındı, okutmalar başlıyor:" << m_taps.count();
+    }
+    m_report.polls++;
+
+    QByteArray response = m_cardPresent ? createUidResponse(m_currentUid) : createEmptyResponse();
+    if (::write(m_masterFd, response.constData(), response.size()) != response.size()) {
+        qDebug() << "Yanıt yazılamadı:" << strerror(errno);
+    }
+
+    if (m_cardPresent && !m_cardServed) {
+        m_cardServed = true;
+        cardServed(m_currentUid, m_clock.elapsed());
+    }
+}
+
+void ReaderSimulator::cardServed(const CardUid& uid, qint64 nowMs)
+{
+    int studentId = studentIdFor(uid);
+    if (studentId < 0) {
+        m_report.unknown++;
+    } else if (m_pending.contains(studentId) || m_recordedStudents.contains(studentId)) {
+        m_report.repeats++;
+    } else {
+        m_pending.insert(studentId, nowMs);
+    }
+}
+
+int ReaderSimulator::studentIdFor(const CardUid& uid)
+{
+    auto it = m_studentIds.constFind(uid);
+    if (it != m_studentIds.constEnd()) return it.value();
+
+    QSqlQuery query(m_db);
+    query.prepare("SELECT id FROM students WHERE cardUID = :cardUID");
+    query.bindValue(":cardUID", uid.toByteArray());
+    int studentId = (query.exec() && query.next()) ? query.value(0).toInt() : -1;
+    m_studentIds.insert(uid, studentId);
+    return studentId;
+}
+
+void ReaderSimulator::onTick()
+{
+    if (!m_clock.isValid()) return;
+    qint64 nowMs = m_clock.elapsed();
+
+    if (m_cardPresent && nowMs >= m_cardRemoveAtMs) {
+        if (!m_cardServed) m_report.missed++;
+        m_cardPresent = false;
+    }
+    // Tek okuyucu: önceki kart kalkmadan sıradaki okutma bekler
+    if (!m_cardPresent && m_nextTap < m_taps.count() && nowMs >= m_taps.at(m_nextTap).atMs) {
+        m_currentUid = m_taps.at(m_nextTap++).uid;
+        m_cardPresent = true;
+        m_cardServed = false;
+        m_cardRemoveAtMs = nowMs + m_dwellMs;
+        m_report.taps++;
+    }
+}
+
+void ReaderSimulator::onRecordCheck()
+{
+    if (!m_clock.isValid()) return;
+    qint64 nowMs = m_clock.elapsed();
+
+    checkRecords(nowMs);
+
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (nowMs - it.value() > m_recordTimeoutMs) {
+            m_report.lost++;
+            it = m_pending.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (!m_cardPresent && m_nextTap >= m_taps.count() && m_pending.isEmpty()) {
+        m_tickTimer->stop();
+        m_recordTimer->stop();
+        m_report.elapsedMs = nowMs;
+        emit finished();
+    }
+}
+
+void ReaderSimulator::checkRecords(qint64 nowMs)
+{
+    QSqlQuery query(m_db);
+    query.prepare("SELECT id, studentId FROM attendanceRecords WHERE id > :lastId ORDER BY id");
+    query.bindValue(":lastId", m_lastRecordId);
+    if (!query.exec()) {
+        qDebug() << "Yoklama kayıtları okunamadı:" << query.lastError().text();
+        return;
+    }
+
+    while (query.next()) {
+        m_lastRecordId = query.value(0).toLongLong();
+        int studentId = query.value(1).toInt();
+        auto it = m_pending.find(studentId);
+        if (it == m_pending.end()) continue; // Başka bir okuyucudan ya da elle eklenmiş
+
+        m_report.latenciesMs.append(nowMs - it.value());
+        m_report.recorded++;
+        m_recordedStudents.insert(studentId);
+        m_pending.erase(it);
+    }
+}
+
+void ReaderSimulator::printReport() const
+{
+    QVector<qint64> sorted = m_report.latenciesMs;
+    std::sort(sorted.begin(), sorted.end());
+
+    QTextStream out(stdout);
+    out << "Süre: " << m_report.elapsedMs << " ms, yoklama paketi: " << m_report.polls
+        << ", hatalı çerçeve: " << m_report.badFrames << "\n";
+    out << "Okutma: " << m_report.taps << ", yoklanmadan kalkan: " << m_report.missed
+        << ", bilinmeyen kart: " << m_report.unknown << ", tekrar: " << m_report.repeats << "\n";
+    out << "Kaydedilen: " << m_report.recorded << ", kaybolan (" << m_recordTimeoutMs
+        << " ms içinde görülmedi): " << m_report.lost << "\n";
+    if (!sorted.isEmpty()) {
+        out << "Okutma-kayıt gecikmesi (ms, kayıt kontrolü her " << kRecordCheckMs << " ms): p50 " << percentile(sorted, 0.50)
+            << "  p90 " << percentile(sorted, 0.90) << "  p99 " << percentile(sorted, 0.99)
+            << "  en fazla " << sorted.last() << "\n";
+    }
+}
+
+QByteArray ReaderSimulator::createUidResponse(const CardUid& uid)
+{
+    QByteArray data("\xDF\x0D", 2);
+    data.append(static_cast<char>(uid.length()));
+    data.append(uid.toByteArray());
+    return createResponse(data);
+}
+
+QByteArray ReaderSimulator::createEmptyResponse()
+{
+    return createResponse(QByteArray());
+}
+
+QByteArray ReaderSimulator::createResponse(const QByteArray& data)
+{
+    // STX | LEN | PCB | INS | DATA... | LRC | ETX (createPollPacket ile aynı düzen)
+    QByteArray packet;
+    packet.append(static_cast<char>(STX));
+    packet.append(static_cast<char>(CardFrameDecoder::kMinFrameLength + data.length()));
+    packet.append(static_cast<char>(PCB));
+    packet.append(static_cast<char>(INS_DO));
+    packet.append(data);
+    packet.append(static_cast<char>(CardFrameDecoder::calculateLRC(packet.constData(), packet.size())));
+    packet.append(static_cast<char>(ETX));
+    return packet;
+}
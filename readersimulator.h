@@ -0,0 +1,115 @@
+#ifndef READERSIMULATOR_H
+#define READERSIMULATOR_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+#include <QElapsedTimer>
+#include <QSqlDatabase>
+#include "cardframedecoder.h"
+#include "carduid.h"
+
+class QSocketNotifier;
+class QTimer;
+
+struct SimulatedTap {
+    qint64 atMs;  // İlk yoklama paketinden itibaren okutma zamanı
+    CardUid uid;
+};
+
+struct ReaderSimulatorReport {
+    int taps = 0;        // Okuyucuya konan kartlar
+    int missed = 0;      // Kart kalkana kadar hiç yoklanmadı
+    int unknown = 0;     // Veritabanında olmayan kartlar (kayıt beklenmez)
+    int repeats = 0;     // Aynı öğrencinin tekrar okutması (yeni kayıt beklenmez)
+    int recorded = 0;    // attendanceRecords'ta satırı görülenler
+    int lost = 0;        // Yoklandı ama zaman aşımına kadar satırı görülmedi
+    qint64 polls = 0;
+    qint64 badFrames = 0;        // Yoklama paketi olmayan çerçeveler
+    qint64 elapsedMs = 0;
+    QVector<qint64> latenciesMs; // Kartın ilk yoklanmasından satırın görülmesine kadar
+};
+
+// Linux/macOS pseudo-terminal üzerinde kart okuyucu gibi davranan simülatör.
+// Uygulamanın yoklama paketine (CardReaderWorker::createPollPacket) kart varsa
+// DF 0D etiketli UID yanıtıyla, yoksa boş yanıtla cevap verir. Okutmalar betikten ya da
+// aktif oturumun öğrencilerinden rastgele üretilir; her okutmanın aynı veritabanı
+// dosyasında attendanceRecords satırı olarak görünme süresi ölçülür.
+class ReaderSimulator : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kTickMs = 2;         // Kart konma/kalkma çözünürlüğü
+    // Kayıt kontrolü çözünürlüğü; ölçülen yazıcının commit'iyle kilit için yarışmamak için seyrek
+    static constexpr int kRecordCheckMs = 15;
+
+    explicit ReaderSimulator(QObject* parent = nullptr);
+    ~ReaderSimulator();
+
+    // pty açar, uygulamanın bağlanacağı uç yolunu döner (hata olursa boş)
+    QString openTerminal();
+    bool openDatabase(const QString& path);
+
+    // Her satır "ms UID", ör. "250 04 A1 B2 C3"; boş ve # ile başlayan satırlar atlanır
+    bool loadScript(const QString& path);
+    // Aktif oturumun yoklaması alınmamış öğrencilerinden, saniyede ortalama
+    // tapsPerSecond okutma (üstel aralıklar); unknownRatio oranında sistemde olmayan kart
+    bool generateRandom(int count, double tapsPerSecond, double unknownRatio = 0.0);
+
+    void setDwellMs(int ms) { m_dwellMs = qMax(1, ms); }
+    void setRecordTimeoutMs(int ms) { m_recordTimeoutMs = qMax(1, ms); }
+
+    const ReaderSimulatorReport& report() const { return m_report; }
+    void printReport() const;
+
+    static QByteArray createUidResponse(const CardUid& uid);
+    static QByteArray createEmptyResponse();
+
+signals:
+    // Tüm okutmalar yapıldı ve bekleyen kayıtlar görüldü ya da zaman aşımına uğradı
+    void finished();
+
+private slots:
+    void onTerminalReadable();
+    void onTick();
+    void onRecordCheck();
+
+private:
+    static QByteArray createResponse(const QByteArray& data);
+
+    void handleFrame(const QByteArray& frame);
+    void cardServed(const CardUid& uid, qint64 nowMs);
+    int studentIdFor(const CardUid& uid);
+    void checkRecords(qint64 nowMs);
+
+    int m_masterFd;
+    int m_slaveFd; // Uygulama bağlı değilken master'ın EIO vermemesi için açık tutulur
+    QSocketNotifier* m_notifier;
+    QTimer* m_tickTimer;
+    QTimer* m_recordTimer;
+    CardFrameDecoder m_decoder;
+    QByteArray m_pollPacket;
+
+    QSqlDatabase m_db;
+    qint64 m_lastRecordId;
+    QHash<CardUid, int> m_studentIds; // -1: veritabanında yok
+
+    QVector<SimulatedTap> m_taps;
+    int m_nextTap;
+    bool m_cardPresent;
+    bool m_cardServed;
+    CardUid m_currentUid;
+    qint64 m_cardRemoveAtMs;
+
+    QHash<int, qint64> m_pending; // studentId -> ilk yoklandığı an
+    QSet<int> m_recordedStudents;
+
+    int m_dwellMs;
+    int m_recordTimeoutMs;
+    QElapsedTimer m_clock; // İlk yoklama paketinde başlar
+    ReaderSimulatorReport m_report;
+};
+
+#endif // READERSIMULATOR_H
@@ -0,0 +1,67 @@
+#include "readersimulator.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QDebug>
+
+// Kart okuyucu simülatörü: fiziksel okuyucu olmadan kart okutma hattını uçtan uca dener.
+// Kullanım: simülatörü başlatın, yazdığı pty yolunu yoklama_ayarlar.ini içinde
+// [CardReaders] ports= değerine yazın, uygulamada yoklamayı başlatın.
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Pseudo-terminal üzerinde kart okuyucu simülatörü ve okutma yük üreticisi");
+    parser.addHelpOption();
+    QCommandLineOption dbOption("db", "Uygulamanın kullandığı veritabanı dosyası.", "yol", "yoklama_sistemi.db");
+    QCommandLineOption scriptOption("script", "\"ms UID\" satırlarından oluşan okutma betiği.", "dosya");
+    QCommandLineOption countOption("count", "Rastgele okutma sayısı.", "sayı", "50");
+    QCommandLineOption rateOption("rate", "Saniyedeki ortalama rastgele okutma.", "sayı", "2");
+    QCommandLineOption unknownOption("unknown", "Rastgele okutmalarda sistemde olmayan kart oranı (0-1).", "oran", "0");
+    QCommandLineOption dwellOption("dwell", "Kartın okuyucu üzerinde kalma süresi (ms).", "ms", "300");
+    QCommandLineOption timeoutOption("timeout", "Kaydın görülmesi için beklenecek en uzun süre (ms).", "ms", "5000");
+    QCommandLineOption linkOption("link", "pty ucuna sabit bir sembolik bağlantı oluştur, ör. /tmp/yoklama_okuyucu.", "yol");
+    parser.addOptions({dbOption, scriptOption, countOption, rateOption, unknownOption, dwellOption, timeoutOption, linkOption});
+    parser.process(app);
+
+    ReaderSimulator simulator;
+    simulator.setDwellMs(parser.value(dwellOption).toInt());
+    simulator.setRecordTimeoutMs(parser.value(timeoutOption).toInt());
+
+    if (!simulator.openDatabase(parser.value(dbOption))) {
+        return 1;
+    }
+
+    bool tapsReady = parser.isSet(scriptOption)
+        ? simulator.loadScript(parser.value(scriptOption))
+        : simulator.generateRandom(parser.value(countOption).toInt(), qMax(0.01, parser.value(rateOption).toDouble()),
+                                   qBound(0.0, parser.value(unknownOption).toDouble(), 1.0));
+    if (!tapsReady) {
+        return 1;
+    }
+
+    QString portPath = simulator.openTerminal();
+    if (portPath.isEmpty()) {
+        return 1;
+    }
+    if (parser.isSet(linkOption)) {
+        QString linkPath = parser.value(linkOption);
+        QFile::remove(linkPath);
+        if (QFile::link(portPath, linkPath)) {
+            portPath = linkPath;
+        } else {
+            qDebug() << "Sembolik bağlantı oluşturulamadı:" << linkPath;
+        }
+    }
+    qDebug().noquote() << "Okuyucu hazır:" << portPath
+                       << "\nyoklama_ayarlar.ini -> [CardReaders] ports=" + portPath
+                       << "\nUygulamada yoklamayı başlatın; okutmalar ilk yoklama paketiyle başlar.";
+
+    QObject::connect(&simulator, &ReaderSimulator::finished, &app, [&]() {
+        simulator.printReport();
+        app.quit();
+    });
+    return app.exec();
+}
@@ -0,0 +1,55 @@
+#include "recenttapcache.h"
+
+RecentTapCache::RecentTapCache(int capacity, int windowMs)
+    : m_entries(qMax(1, capacity))
+    , m_windowMs(windowMs)
+    , m_hits(0)
+    , m_misses(0)
+{
+}
+
+bool RecentTapCache::contains(int sessionId, const CardUid& uid, qint64 nowMs)
+{
+    for (const Entry& entry : m_entries) {
+        if (entry.sessionId == sessionId && nowMs - entry.atMs < m_windowMs && entry.uid == uid) {
+            m_hits++;
+            return true;
+        }
+    }
+    m_misses++;
+    return false;
+}
+
+void RecentTapCache::insert(int sessionId, const CardUid& uid, qint64 nowMs)
+{
+    // Aynı çift varsa zamanı yenilenir, yoksa en eski (veya boş) kaydın yerine yazılır
+    Entry* target = &m_entries[0];
+    for (Entry& entry : m_entries) {
+        if (entry.sessionId == sessionId && entry.uid == uid) {
+            target = &entry;
+            break;
+        }
+        if (entry.atMs < target->atMs) {
+            target = &entry;
+        }
+    }
+    target->sessionId = sessionId;
+    target->uid = uid;
+    target->atMs = nowMs;
+}
+
+void RecentTapCache::remove(int sessionId, const CardUid& uid)
+{
+    for (Entry& entry : m_entries) {
+        if (entry.sessionId == sessionId && entry.uid == uid) {
+            entry = Entry();
+        }
+    }
+}
+
+void RecentTapCache::clear()
+{
+    for (Entry& entry : m_entries) {
+        entry = Entry();
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef RECENTTAPCACHE_H
+#define RECENTTAPCACHE_H
+
+#include <QVector>
+#include "carduid.h"
+
+// Yakın zamanda işlenmiş (oturum, kart UID) çiftlerinin küçük, sabit boyutlu önbelleği.
+// Süre penceresi içinde tekrar gelen okuma SQL'e ve oturum listesine gitmeden elenir.
+// Dolduğunda en eski kayıt atılır.
+class RecentTapCache
+{
+public:
+    explicit RecentTapCache(int capacity = 64, int windowMs = 5000);
+
+    void setWindowMs(int windowMs) { m_windowMs = windowMs; }
+    int windowMs() const { return m_windowMs; }
+
+    // Pencere içinde işlenmişse true döner; isabet/ıska sayaçlarını günceller
+    bool contains(int sessionId, const CardUid& uid, qint64 nowMs);
+    void insert(int sessionId, const CardUid& uid, qint64 nowMs);
+    // Çifti önbellekten çıkarır; sonraki okuma pencere içinde olsa da işlenir
+    void remove(int sessionId, const CardUid& uid);
+    void clear();
+
+    qint64 hits() const { return m_hits; }
+    qint64 misses() const { return m_misses; }
+
+private:
+    struct Entry {
+        int sessionId = -1;
+        CardUid uid;
+        qint64 atMs = 0;
+    };
+
+    QVector<Entry> m_entries;
+    int m_windowMs;
+    qint64 m_hits;
+    qint64 m_misses;
+};
+
+#endif // RECENTTAPCACHE_H
@@ -0,0 +1,239 @@
+#ifndef RECORDTABLEMODEL_H
+#define RECORDTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QVector>
+#include <QHash>
+#include <QString>
+#include <QVariant>
+#include <functional>
+#include <algorithm>
+#include <numeric>
+
+// DatabaseManager'ın döndürdüğü kayıt vektörlerini (AttendanceRecord, AttendanceSession,
+// AdminAttendanceOverview...) doğrudan QTableView'a gösteren hafif tablo modeli.
+// Hücre başına QTableWidgetItem yerine satır başına tek kayıt tutulur; hücre metni
+// sütun tanımındaki fonksiyonla yalnızca görünen satırlar çizilirken üretilir.
+template<typename T>
+class RecordTableModel : public QAbstractTableModel
+{
+public:
+    struct Column {
+        QString header;
+        std::function<QVariant(const T&)> display;
+        std::function<QVariant(const T&)> foreground = nullptr; // İsteğe bağlı yazı rengi
+    };
+
+    explicit RecordTableModel(const QVector<Column>& columns, QObject* parent = nullptr)
+        : QAbstractTableModel(parent)
+        , m_columns(columns)
+        , m_sortColumn(-1)
+        , m_sortOrder(Qt::AscendingOrder)
+        , m_keysDirty(false)
+        , m_canFetchMore(false)
+        , m_fetching(false)
+    {
+    }
+
+    // Satırları bir anahtarla (ör. öğrenci numarası) bulmak için; rowForKey bunu kullanır
+    void setKeyFunction(std::function<QString(const T&)> key)
+    {
+        m_key = key;
+        m_keysDirty = true;
+    }
+
+    // Sayfalı listeler: görünüm son satıra yaklaştığında fetch çağrılır; fetch sonraki sayfayı
+    // (genelde arka planda) alıp appendRecords ile ekler. Sayfalar sıralamaya göre değil sona eklenir.
+    void setFetchMoreFunction(std::function<void()> fetch) { m_fetchMore = fetch; }
+
+    bool canFetchMore(const QModelIndex& parent) const override
+    {
+        return !parent.isValid() && m_fetchMore && m_canFetchMore && !m_fetching;
+    }
+
+    void fetchMore(const QModelIndex& parent) override
+    {
+        if (!canFetchMore(parent)) return;
+        // Sayfa gelene kadar aynı istek tekrar gönderilmez
+        m_fetching = true;
+        m_fetchMore();
+    }
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : m_records.count();
+    }
+
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : m_columns.count();
+    }
+
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override
+    {
+        if (!index.isValid() || index.row() >= m_records.count()) return QVariant();
+        const Column& column = m_columns.at(index.column());
+        const T& record = m_records.at(index.row());
+
+        if (role == Qt::DisplayRole && column.display) {
+            return column.display(record);
+        }
+        if (role == Qt::ForegroundRole && column.foreground) {
+            return column.foreground(record);
+        }
+        return QVariant();
+    }
+
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override
+    {
+        if (orientation == Qt::Horizontal && role == Qt::DisplayRole
+            && section >= 0 && section < m_columns.count()) {
+            return m_columns.at(section).header;
+        }
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override
+    {
+        m_sortColumn = column;
+        m_sortOrder = order;
+        if (column < 0 || column >= m_columns.count() || m_records.count() < 2) return;
+
+        emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+
+        QVector<int> sortedRows(m_records.count());
+        std::iota(sortedRows.begin(), sortedRows.end(), 0);
+        std::stable_sort(sortedRows.begin(), sortedRows.end(), [this](int left, int right) {
+            return rowLessThan(m_records.at(left), m_records.at(right));
+        });
+
+        QVector<T> sorted;
+        sorted.reserve(m_records.count());
+        QVector<int> newRow(m_records.count());
+        for (int i = 0; i < sortedRows.count(); ++i) {
+            sorted.append(m_records.at(sortedRows.at(i)));
+            newRow[sortedRows.at(i)] = i;
+        }
+
+        // Seçim gibi kalıcı indeksler satırlarıyla birlikte taşınır
+        const QModelIndexList from = persistentIndexList();
+        QModelIndexList to;
+        to.reserve(from.count());
+        for (const QModelIndex& index : from) {
+            to.append(this->index(newRow.at(index.row()), index.column()));
+        }
+        changePersistentIndexList(from, to);
+
+        m_records = sorted;
+        m_keysDirty = true;
+        emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+    }
+
+    // Tüm kayıtları değiştirir; görünüm sıralıysa aynı sütuna göre yeniden sıralanır
+    void setRecords(const QVector<T>& records)
+    {
+        beginResetModel();
+        m_records = records;
+        m_keysDirty = true;
+        m_canFetchMore = false;
+        m_fetching = false;
+        endResetModel();
+
+        if (m_sortColumn >= 0) {
+            sort(m_sortColumn, m_sortOrder);
+        }
+    }
+
+    void clear() { setRecords(QVector<T>()); }
+
+    // Gelen sayfayı sona ekler; hasMore false ise görünüm daha fazla sayfa istemez
+    void appendRecords(const QVector<T>& records, bool hasMore)
+    {
+        m_fetching = false;
+        m_canFetchMore = hasMore;
+        if (records.isEmpty()) return;
+
+        beginInsertRows(QModelIndex(), m_records.count(), m_records.count() + records.count() - 1);
+        m_records += records;
+        m_keysDirty = true;
+        endInsertRows();
+    }
+
+    // Tek kaydı geçerli sıralamadaki yerine ekler (sıralama yoksa sona), satır indeksini döner
+    int insertSorted(const T& record)
+    {
+        int row = m_records.count();
+        if (m_sortColumn >= 0 && m_sortColumn < m_columns.count()) {
+            auto position = std::upper_bound(m_records.begin(), m_records.end(), record,
+                [this](const T& left, const T& right) { return rowLessThan(left, right); });
+            row = int(position - m_records.begin());
+        }
+
+        beginInsertRows(QModelIndex(), row, row);
+        m_records.insert(row, record);
+        m_keysDirty = true;
+        endInsertRows();
+        return row;
+    }
+
+    // Satırın kaydını değiştirir, yalnızca o satırın hücreleri yeniden çizilir
+    void updateRecord(int row, const T& record)
+    {
+        if (row < 0 || row >= m_records.count()) return;
+        m_records[row] = record;
+        m_keysDirty = true;
+        emit dataChanged(index(row, 0), index(row, m_columns.count() - 1));
+    }
+
+    const T& record(int row) const { return m_records.at(row); }
+    const QVector<T>& records() const { return m_records; }
+
+    // setKeyFunction ile verilen anahtara sahip satır, yoksa -1
+    int rowForKey(const QString& key) const
+    {
+        if (!m_key) return -1;
+        if (m_keysDirty) {
+            m_rowForKey.clear();
+            m_rowForKey.reserve(m_records.count());
+            for (int row = 0; row < m_records.count(); ++row) {
+                m_rowForKey.insert(m_key(m_records.at(row)), row);
+            }
+            m_keysDirty = false;
+        }
+        return m_rowForKey.value(key, -1);
+    }
+
+private:
+    bool rowLessThan(const T& left, const T& right) const
+    {
+        const Column& column = m_columns.at(m_sortColumn);
+        QVariant leftValue = column.display(left);
+        QVariant rightValue = column.display(right);
+        return m_sortOrder == Qt::AscendingOrder ? valueLessThan(leftValue, rightValue)
+                                                 : valueLessThan(rightValue, leftValue);
+    }
+
+    static bool valueLessThan(const QVariant& left, const QVariant& right)
+    {
+        // QTableWidgetItem ile aynı: metinler büyük/küçük harf duyarlı karşılaştırılır
+        if (left.userType() == QMetaType::QString && right.userType() == QMetaType::QString) {
+            return left.toString() < right.toString();
+        }
+        return QVariant::compare(left, right) == QPartialOrdering::Less;
+    }
+
+    QVector<Column> m_columns;
+    QVector<T> m_records;
+    int m_sortColumn;
+    Qt::SortOrder m_sortOrder;
+
+    std::function<QString(const T&)> m_key;
+    mutable QHash<QString, int> m_rowForKey;
+    mutable bool m_keysDirty;
+
+    std::function<void()> m_fetchMore;
+    bool m_canFetchMore;
+    bool m_fetching;
+};
+
+#endif // RECORDTABLEMODEL_H
@@ -0,0 +1,392 @@
+#include "schemamigrator.h"
+#include "carduid.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QStringList>
+#include <QSet>
+#include <QDateTime>
+#include <QDebug>
+
+namespace {
+
+bool execAll(QSqlDatabase& db, const QStringList& statements)
+{
+    QSqlQuery query(db);
+    for (const QString& statement : statements) {
+        if (!query.exec(statement)) {
+            qDebug() << "Şema komutu çalıştırılamadı:" << query.lastError().text();
+            qDebug() << "Komut:" << statement;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool hasColumn(QSqlDatabase& db, const QString& table, const QString& column)
+{
+    QSqlQuery query(db);
+    if (!query.exec("PRAGMA table_info(" + table + ")")) {
+        return false;
+    }
+    while (query.next()) {
+        if (query.value(1).toString() == column) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Sürüm 1: temel tablolar, eski veritabanlarındaki eksik sütunlar ve örnek veriler
+bool migrateBaseSchema(QSqlDatabase& db)
+{
+    if (!execAll(db, {
+            // Kullanıcılar tablosu (admin ve öğretmenler)
+            "CREATE TABLE IF NOT EXISTS users ("
+            "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+            "username TEXT UNIQUE NOT NULL, "
+            "password TEXT NOT NULL, "
+            "fullName TEXT NOT NULL, "
+            "role TEXT NOT NULL, "
+            "email TEXT UNIQUE NOT NULL, "
+            "createdAt TEXT NOT NULL)",
+
+            // Öğrenciler tablosu
+            "CREATE TABLE IF NOT EXISTS students ("
+            "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+            "cardUID TEXT UNIQUE NOT NULL, "
+            "studentNumber TEXT UNIQUE NOT NULL, "
+            "firstName TEXT NOT NULL, "
+            "lastName TEXT NOT NULL, "
+            "createdAt TEXT NOT NULL, "
+            "createdBy INTEGER NOT NULL, "
+            "password TEXT, "
+            "FOREIGN KEY (createdBy) REFERENCES users(id))",
+
+            // Dersler tablosu
+            "CREATE TABLE IF NOT EXISTS courses ("
+            "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+            "course_name TEXT NOT NULL,"
+            "course_code TEXT NOT NULL UNIQUE,"
+            "teacher_id INTEGER NOT NULL,"
+            "created_by INTEGER NOT NULL,"
+            "created_at DATETIME DEFAULT CURRENT_TIMESTAMP,"
+            "FOREIGN KEY (teacher_id) REFERENCES users(id),"
+            "FOREIGN KEY (created_by) REFERENCES users(id))",
+
+            // Ders kayıtları tablosu
+            "CREATE TABLE IF NOT EXISTS enrollments ("
+            "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+            "courseId INTEGER NOT NULL, "
+            "studentId INTEGER NOT NULL, "
+            "enrolledAt TEXT NOT NULL, "
+            "enrolledBy INTEGER NOT NULL, "
+            "FOREIGN KEY (courseId) REFERENCES courses(id), "
+            "FOREIGN KEY (studentId) REFERENCES students(id), "
+            "FOREIGN KEY (enrolledBy) REFERENCES users(id), "
+            "UNIQUE(courseId, studentId))",
+
+            // Yoklama oturumları tablosu
+            "CREATE TABLE IF NOT EXISTS attendance_sessions ("
+            "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+            "teacher_id INTEGER NOT NULL,"
+            "course_id INTEGER NOT NULL,"
+            "title TEXT NOT NULL,"
+            "start_time DATETIME DEFAULT CURRENT_TIMESTAMP,"
+            "end_time DATETIME,"
+            "is_active BOOLEAN DEFAULT 1,"
+            "FOREIGN KEY (teacher_id) REFERENCES users(id),"
+            "FOREIGN KEY (course_id) REFERENCES courses(id))",
+
+            // Yoklama kayıtları tablosu
+            "CREATE TABLE IF NOT EXISTS attendanceRecords ("
+            "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+            "sessionId INTEGER NOT NULL, "
+            "studentId INTEGER NOT NULL, "
+            "time TEXT NOT NULL, "
+            "status TEXT NOT NULL, "
+            "FOREIGN KEY (sessionId) REFERENCES attendanceSessions(id), "
+            "FOREIGN KEY (studentId) REFERENCES students(id), "
+            "UNIQUE(sessionId, studentId))",
+
+            // Yoklama silme istekleri tablosu
+            "CREATE TABLE IF NOT EXISTS attendanceDeleteRequests ("
+            "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+            "sessionId INTEGER NOT NULL, "
+            "requestedBy INTEGER NOT NULL, "
+            "requestedAt TEXT NOT NULL, "
+            "reason TEXT, "
+            "status TEXT NOT NULL DEFAULT 'pending', "
+            "approvedBy INTEGER, "
+            "approvedAt TEXT, "
+            "FOREIGN KEY (sessionId) REFERENCES attendanceSessions(id), "
+            "FOREIGN KEY (requestedBy) REFERENCES users(id), "
+            "FOREIGN KEY (approvedBy) REFERENCES users(id))"
+        })) {
+        return false;
+    }
+
+    // Sürüm takibinden önce oluşturulmuş veritabanlarında eksik olabilecek sütunlar
+    if (!hasColumn(db, "students", "password")
+        && !execAll(db, {"ALTER TABLE students ADD COLUMN password TEXT"})) {
+        return false;
+    }
+    if (!hasColumn(db, "attendance_sessions", "title")
+        && !execAll(db, {"ALTER TABLE attendance_sessions ADD COLUMN title TEXT NOT NULL DEFAULT 'Yoklama'"})) {
+        return false;
+    }
+
+    // Admin kullanıcısı ve örnek öğretmenler
+    QString now = QDateTime::currentDateTime().toString(Qt::ISODate);
+    QSqlQuery query(db);
+    query.prepare("INSERT OR IGNORE INTO users (username, password, fullName, role, email, createdAt) "
+                  "VALUES (?, ?, ?, ?, ?, ?)");
+    const QStringList seedUsers[] = {
+        {"admin", "admin123", "Sistem Yöneticisi", "admin", "admin@okul.com"},
+        {"o1", "123", "Ahmet Yılmaz", "teacher", "ahmet@okul.com"},
+        {"o2", "123", "Ayşe Demir", "teacher", "ayse@okul.com"}
+    };
+    for (const QStringList& seed : seedUsers) {
+        for (const QString& value : seed) {
+            query.addBindValue(value);
+        }
+        query.addBindValue(now);
+        if (!query.exec()) {
+            qDebug() << "Varsayılan kullanıcı eklenemedi:" << query.lastError().text();
+            return false;
+        }
+    }
+
+    // Örnek dersler (ilk iki öğretmene)
+    query.exec("SELECT id FROM users WHERE role = 'teacher' ORDER BY id LIMIT 2");
+    QVector<int> teacherIds;
+    while (query.next()) {
+        teacherIds.append(query.value(0).toInt());
+    }
+    if (teacherIds.size() >= 2) {
+        if (!execAll(db, {QString("INSERT OR IGNORE INTO courses (course_name, course_code, teacher_id, created_by) VALUES "
+                                  "('Matematik', 'MATH101', %1, 1),"
+                                  "('Fizik', 'PHYS101', %1, 1),"
+                                  "('Kimya', 'CHEM101', %2, 1),"
+                                  "('Biyoloji', 'BIO101', %2, 1)")
+                              .arg(teacherIds[0]).arg(teacherIds[1])})) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Sürüm 2: sık sorgular için ikincil indeksler
+bool migrateQueryIndexes(QSqlDatabase& db)
+{
+    return execAll(db, {
+        // getActiveSessionId (id rowid olarak indekste bulunur)
+        "CREATE INDEX IF NOT EXISTS idx_sessions_teacher_active ON attendance_sessions(teacher_id, is_active)",
+        // getTeacherAttendanceHistoryPage: öğretmene göre, başlangıç zamanına göre sıralı
+        "CREATE INDEX IF NOT EXISTS idx_sessions_teacher_start ON attendance_sessions(teacher_id, start_time)",
+        // getAttendanceSessionsForCoursePage
+        "CREATE INDEX IF NOT EXISTS idx_sessions_course_start ON attendance_sessions(course_id, start_time)",
+        // getAdminAttendanceOverviewPage: tüm oturumlar başlangıç zamanına göre sıralı
+        "CREATE INDEX IF NOT EXISTS idx_sessions_start ON attendance_sessions(start_time)",
+        // getCoursesForStudent (courseId tarafı UNIQUE(courseId, studentId) ile karşılanıyor)
+        "CREATE INDEX IF NOT EXISTS idx_enrollments_student ON enrollments(studentId)",
+        // Öğrenci yoklama geçmişi (sessionId tarafı UNIQUE(sessionId, studentId) ile karşılanıyor)
+        "CREATE INDEX IF NOT EXISTS idx_records_student ON attendanceRecords(studentId)",
+        // getPendingDeleteRequests: duruma göre, istek zamanına göre sıralı
+        "CREATE INDEX IF NOT EXISTS idx_delete_requests_status ON attendanceDeleteRequests(status, requestedAt)",
+        // getCoursesByTeacher / getCoursesForTeacher
+        "CREATE INDEX IF NOT EXISTS idx_courses_teacher ON courses(teacher_id)",
+        "ANALYZE"
+    });
+}
+
+// Sürüm 3: oturum listelerinde her oturum için COUNT(*) yerine tutulan katılımcı sayacı
+bool migrateAttendeeCount(QSqlDatabase& db)
+{
+    if (!hasColumn(db, "attendance_sessions", "attendee_count")
+        && !execAll(db, {"ALTER TABLE attendance_sessions ADD COLUMN attendee_count INTEGER NOT NULL DEFAULT 0"})) {
+        return false;
+    }
+
+    return execAll(db, {
+        "UPDATE attendance_sessions SET attendee_count = "
+        "(SELECT COUNT(*) FROM attendanceRecords r WHERE r.sessionId = attendance_sessions.id)",
+
+        // INSERT OR IGNORE ile yok sayılan satırlar tetikleyiciyi çalıştırmaz
+        "CREATE TRIGGER IF NOT EXISTS trg_records_count_insert AFTER INSERT ON attendanceRecords "
+        "BEGIN "
+        "UPDATE attendance_sessions SET attendee_count = attendee_count + 1 WHERE id = NEW.sessionId; "
+        "END",
+
+        "CREATE TRIGGER IF NOT EXISTS trg_records_count_delete AFTER DELETE ON attendanceRecords "
+        "BEGIN "
+        "UPDATE attendance_sessions SET attendee_count = attendee_count - 1 WHERE id = OLD.sessionId; "
+        "END",
+
+        "CREATE TRIGGER IF NOT EXISTS trg_records_count_move AFTER UPDATE OF sessionId ON attendanceRecords "
+        "WHEN OLD.sessionId <> NEW.sessionId "
+        "BEGIN "
+        "UPDATE attendance_sessions SET attendee_count = attendee_count - 1 WHERE id = OLD.sessionId; "
+        "UPDATE attendance_sessions SET attendee_count = attendee_count + 1 WHERE id = NEW.sessionId; "
+        "END"
+    });
+}
+
+// Sürüm 4: students.cardUID "04 A1 B2 C3" metni yerine ham bayt (BLOB) olarak tutulur.
+// SQLite sütun tipini değiştiremediği için tablo yeniden oluşturulur; id'ler korunur.
+bool migrateBinaryCardUid(QSqlDatabase& db)
+{
+    if (!execAll(db, {
+            "CREATE TABLE students_new ("
+            "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+            "cardUID BLOB UNIQUE NOT NULL, "
+            "studentNumber TEXT UNIQUE NOT NULL, "
+            "firstName TEXT NOT NULL, "
+            "lastName TEXT NOT NULL, "
+            "createdAt TEXT NOT NULL, "
+            "createdBy INTEGER NOT NULL, "
+            "password TEXT, "
+            "FOREIGN KEY (createdBy) REFERENCES users(id))"
+        })) {
+        return false;
+    }
+
+    QSqlQuery select(db);
+    if (!select.exec("SELECT id, cardUID, studentNumber, firstName, lastName, createdAt, createdBy, password FROM students")) {
+        qDebug() << "Öğrenciler okunamadı:" << select.lastError().text();
+        return false;
+    }
+
+    QSqlQuery insert(db);
+    insert.prepare("INSERT INTO students_new (id, cardUID, studentNumber, firstName, lastName, createdAt, createdBy, password) "
+                   "VALUES (?, ?, ?, ?, ?, ?, ?, ?)");
+    int converted = 0;
+    // Eski TEXT UNIQUE sütunu "04A1B2C3" ile "04 a1 b2 c3"ü farklı sayıyordu; ikili biçimde
+    // aynı anahtara düşerler. Çakışan kayıt UNIQUE'e takılıp göçü (ve açılışı) durdurmasın
+    // diye özgün metniyle saklanır.
+    QSet<QByteArray> usedKeys;
+    int collisions = 0;
+    while (select.next()) {
+        QString text = select.value(1).toString();
+        CardUid uid = CardUid::fromString(text);
+        QByteArray key;
+        if (uid.isValid()) {
+            key = uid.toByteArray();
+        } else {
+            // Elle girilmiş, hex olmayan değerler kaybolmasın diye olduğu gibi saklanır
+            qDebug() << "Kart UID'si çözülemedi, metin olarak saklanıyor:" << text;
+            key = text.toUtf8();
+        }
+        if (usedKeys.contains(key)) {
+            qDebug() << "Kart UID'si başka bir öğrenciyle çakışıyor, metin olarak saklanıyor:"
+                     << text << "öğrenci no:" << select.value(2).toString();
+            key = text.toUtf8();
+            if (usedKeys.contains(key)) {
+                key += "#" + select.value(0).toString().toUtf8();
+            }
+            collisions++;
+        }
+        usedKeys.insert(key);
+
+        insert.addBindValue(select.value(0));
+        insert.addBindValue(key);
+        for (int column = 2; column < 8; ++column) {
+            insert.addBindValue(select.value(column));
+        }
+        if (!insert.exec()) {
+            qDebug() << "Öğrenci taşınamadı:" << select.value(2).toString() << insert.lastError().text();
+            return false;
+        }
+        converted++;
+    }
+    // DROP TABLE için okuma sorgusu kapatılmalı
+    select.finish();
+
+    qDebug() << "Kart UID'si ikili biçime çevrilen öğrenci sayısı:" << converted << "çakışan:" << collisions;
+    return execAll(db, {
+        "DROP TABLE students",
+        "ALTER TABLE students_new RENAME TO students"
+    });
+}
+
+} // namespace
+
+const QVector<SchemaMigrator::Migration>& SchemaMigrator::migrations()
+{
+    // Yeni adımlar her zaman listenin sonuna, bir sonraki sürüm numarasıyla eklenir
+    static const QVector<Migration> steps = {
+        {1, "Temel tablolar ve varsayılan veriler", &migrateBaseSchema},
+        {2, "Sık sorgular için indeksler", &migrateQueryIndexes},
+        {3, "Oturum katılımcı sayacı", &migrateAttendeeCount},
+        {4, "İkili kart UID anahtarı", &migrateBinaryCardUid},
+    };
+    return steps;
+}
+
+int SchemaMigrator::latestVersion()
+{
+    return migrations().isEmpty() ? 0 : migrations().last().version;
+}
+
+int SchemaMigrator::currentVersion(QSqlDatabase& db)
+{
+    QSqlQuery query(db);
+    if (query.exec("PRAGMA user_version") && query.next()) {
+        return query.value(0).toInt();
+    }
+    qDebug() << "Şema sürümü okunamadı:" << query.lastError().text();
+    return -1;
+}
+
+bool SchemaMigrator::migrate(QSqlDatabase& db)
+{
+    int version = currentVersion(db);
+    if (version < 0) {
+        return false;
+    }
+    if (version == latestVersion()) {
+        return true;
+    }
+    if (version > latestVersion()) {
+        qDebug() << "Veritabanı şema sürümü" << version << "bu programın desteklediğinden yeni:" << latestVersion();
+        return false;
+    }
+
+    for (const Migration& migration : migrations()) {
+        if (migration.version <= version) continue;
+        if (!applyMigration(db, migration)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SchemaMigrator::applyMigration(QSqlDatabase& db, const Migration& migration)
+{
+    qDebug() << "Şema güncelleniyor, sürüm" << migration.version << "-" << migration.description;
+
+    if (!db.transaction()) {
+        qDebug() << "Şema güncellemesi için transaction açılamadı:" << db.lastError().text();
+        return false;
+    }
+
+    if (!migration.apply(db)) {
+        db.rollback();
+        qDebug() << "Şema sürümü" << migration.version << "uygulanamadı, değişiklikler geri alındı.";
+        return false;
+    }
+
+    // PRAGMA user_version transaction ile birlikte commit edilir
+    QSqlQuery query(db);
+    if (!query.exec(QString("PRAGMA user_version = %1").arg(migration.version))) {
+        qDebug() << "Şema sürümü yazılamadı:" << query.lastError().text();
+        db.rollback();
+        return false;
+    }
+
+    if (!db.commit()) {
+        qDebug() << "Şema güncellemesi commit edilemedi:" << db.lastError().text();
+        db.rollback();
+        return false;
+    }
+    return true;
+}
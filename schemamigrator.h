@@ -0,0 +1,30 @@
+#ifndef SCHEMAMIGRATOR_H
+#define SCHEMAMIGRATOR_H
+
+#include <QSqlDatabase>
+#include <QVector>
+
+// PRAGMA user_version tabanlı şema sürümleme.
+// Her adım sırayla ve kendi transaction'ı içinde uygulanır; veritabanı güncelse
+// açılışta sadece tek bir tamsayı okunur.
+class SchemaMigrator
+{
+public:
+    // Eksik adımları uygular, hata olursa false döner
+    static bool migrate(QSqlDatabase& db);
+
+    static int currentVersion(QSqlDatabase& db);
+    static int latestVersion();
+
+private:
+    struct Migration {
+        int version;
+        const char* description;
+        bool (*apply)(QSqlDatabase& db);
+    };
+
+    static const QVector<Migration>& migrations();
+    static bool applyMigration(QSqlDatabase& db, const Migration& migration);
+};
+
+#endif // SCHEMAMIGRATOR_H
@@ -0,0 +1,109 @@
+#include "sessionroster.h"
+#include <QHash>
+#include <QDebug>
+
+SessionRoster::SessionRoster()
+    : m_sessionId(-1)
+    , m_courseId(-1)
+    , m_mask(0)
+{
+}
+
+void SessionRoster::build(int sessionId, int courseId, const QVector<SessionRosterEntry>& entries)
+{
+    clear();
+    m_sessionId = sessionId;
+    m_courseId = courseId;
+
+    m_students.reserve(entries.count());
+    m_present.resize(entries.count());
+    rehash(entries.count());
+
+    for (const auto& entry : entries) {
+        // Kartı olmayan öğrenci kart okutamaz, listeye alınmaz
+        if (!entry.student.cardUID.isValid()) continue;
+
+        int slot = m_students.count();
+        m_students.append(entry.student);
+        m_present.setBit(slot, entry.present);
+        insertIntoBuckets(slot);
+    }
+    m_present.resize(m_students.count());
+
+    qDebug() << "Oturum listesi hazırlandı, session ID:" << sessionId
+             << "öğrenci:" << m_students.count() << "mevcut:" << presentCount();
+}
+
+void SessionRoster::clear()
+{
+    m_sessionId = -1;
+    m_courseId = -1;
+    m_students.clear();
+    m_present.clear();
+    m_buckets.clear();
+    m_mask = 0;
+}
+
+int SessionRoster::find(const CardUid& cardUID) const
+{
+    if (m_buckets.isEmpty()) return -1;
+
+    int bucket = probe(cardUID);
+    return m_buckets.at(bucket);
+}
+
+int SessionRoster::findStudent(int studentId) const
+{
+    for (int slot = 0; slot < m_students.count(); ++slot) {
+        if (m_students.at(slot).id == studentId) return slot;
+    }
+    return -1;
+}
+
+int SessionRoster::addStudent(const Student& student)
+{
+    if (!isValid() || !student.cardUID.isValid()) return -1;
+
+    int existing = find(student.cardUID);
+    if (existing >= 0) return existing;
+
+    // Doluluk oranını %50'nin altında tut
+    if ((m_students.count() + 1) * 2 > m_buckets.count()) {
+        rehash(m_students.count() + 1);
+    }
+
+    int slot = m_students.count();
+    m_students.append(student);
+    m_present.resize(slot + 1);
+    insertIntoBuckets(slot);
+    return slot;
+}
+
+int SessionRoster::probe(const CardUid& cardUID) const
+{
+    // Aranan UID'nin bulunduğu ya da ekleneceği kovayı döner
+    int bucket = static_cast<int>(qHash(cardUID) & m_mask);
+    while (m_buckets.at(bucket) >= 0 && m_students.at(m_buckets.at(bucket)).cardUID != cardUID) {
+        bucket = (bucket + 1) & m_mask;
+    }
+    return bucket;
+}
+
+void SessionRoster::insertIntoBuckets(int slot)
+{
+    m_buckets[probe(m_students.at(slot).cardUID)] = slot;
+}
+
+void SessionRoster::rehash(int minimumCapacity)
+{
+    int capacity = 16;
+    while (capacity < minimumCapacity * 2) {
+        capacity <<= 1;
+    }
+
+    m_buckets.fill(-1, capacity);
+    m_mask = capacity - 1;
+    for (int slot = 0; slot < m_students.count(); ++slot) {
+        insertIntoBuckets(slot);
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef SESSIONROSTER_H
+#define SESSIONROSTER_H
+
+#include <QVector>
+#include <QBitArray>
+#include <QString>
+#include "databasemanager.h"
+
+// Aktif yoklama oturumunun bellekteki ders listesi.
+// Kart UID'si ile açık adresli (linear probing) bir hash tablosundan
+// öğrenci slotuna ulaşılır; yoklama durumu slot başına bir bit ile tutulur.
+// Böylece kart okutmada öğrenci, ders kaydı ve tekrar kontrolü SQL okuması yapmadan çözülür.
+class SessionRoster
+{
+public:
+    SessionRoster();
+
+    void build(int sessionId, int courseId, const QVector<SessionRosterEntry>& entries);
+    void clear();
+
+    bool isValid() const { return m_sessionId > 0; }
+    int sessionId() const { return m_sessionId; }
+    int courseId() const { return m_courseId; }
+    int count() const { return m_students.count(); }
+    int presentCount() const { return m_present.count(true); }
+
+    // Kart UID'sine ait slotu döner, listede yoksa -1
+    int find(const CardUid& cardUID) const;
+    const Student& student(int slot) const { return m_students.at(slot); }
+    bool isPresent(int slot) const { return m_present.testBit(slot); }
+    void markPresent(int slot) { m_present.setBit(slot); }
+    void clearPresent(int slot) { m_present.clearBit(slot); }
+
+    // Öğrenci ID'sine ait slot, yoksa -1 (doğrusal arama; sadece yazma hatası gibi nadir yollar için)
+    int findStudent(int studentId) const;
+
+    // Oturum sırasında derse eklenen öğrenciyi listeye ekler (varsa mevcut slotu döner)
+    int addStudent(const Student& student);
+
+private:
+    int probe(const CardUid& cardUID) const;
+    void insertIntoBuckets(int slot);
+    void rehash(int minimumCapacity);
+
+    int m_sessionId;
+    int m_courseId;
+    QVector<Student> m_students;
+    QBitArray m_present;
+    QVector<int> m_buckets;   // -1: boş, aksi halde m_students içindeki slot
+    int m_mask;
+};
+
+#endif // SESSIONROSTER_H
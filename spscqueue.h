@@ -0,0 +1,52 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <utility>
+
+// Tek üretici / tek tüketici için kilitsiz, sabit kapasiteli halka kuyruk.
+// push sadece üretici thread'den, pop sadece tüketici thread'den çağrılmalı.
+template <typename T, int Capacity>
+class SpscQueue
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Kapasite 2'nin kuvveti olmalı");
+
+public:
+    // Kuyruk doluysa false döner, eleman eklenmez
+    bool push(const T& value)
+    {
+        const quint32 tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == static_cast<quint32>(Capacity)) {
+            return false;
+        }
+        m_items[tail & (Capacity - 1)] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& value)
+    {
+        const quint32 head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = std::move(m_items[head & (Capacity - 1)]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Yaklaşık doluluk (diğer thread aynı anda değiştirebilir)
+    int size() const
+    {
+        return static_cast<int>(m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire));
+    }
+
+private:
+    // Üretici ve tüketici sayaçları aynı önbellek satırını paylaşmasın
+    alignas(64) std::atomic<quint32> m_head{0};
+    alignas(64) std::atomic<quint32> m_tail{0};
+    T m_items[Capacity];
+};
+
+#endif // SPSCQUEUE_H
@@ -2,9 +2,10 @@
 #include "ui_studentwidget.h"
 #include <QMessageBox>
 #include <QComboBox>
-#include <QTableWidget>
+#include <QTableView>
 #include <QHeaderView>
 #include <QPushButton>
+#include "tablehelper.h"
 
 StudentWidget::StudentWidget(const User& student, QWidget* parent)
     : QWidget(parent)
@@ -14,6 +15,13 @@ StudentWidget::StudentWidget(const User& student, QWidget* parent)
 {
     ui->setupUi(this);
     setWindowTitle("Öğrenci Paneli - " + m_student.fullName);
+    m_attendanceModel = new RecordTableModel<StudentAttendanceEntry>({
+        {"Ders", [](const StudentAttendanceEntry& entry) { return entry.courseName; }},
+        {"Tarih", [](const StudentAttendanceEntry& entry) { return entry.startTime.toString("yyyy-MM-dd"); }},
+        {"Durum", [](const StudentAttendanceEntry& entry) { return QString(entry.present ? "Var" : "Yok"); }},
+        {"Saat", [](const StudentAttendanceEntry& entry) { return entry.present ? entry.time : QString("-"); }}
+    }, this);
+    ui->attendanceTable->setModel(m_attendanceModel);
     ui->attendanceTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
     loadAttendanceHistory();
     connect(ui->logoutButton, &QPushButton::clicked, this, [this]() {
@@ -49,30 +57,22 @@ void StudentWidget::loadAttendanceHistory()
 void StudentWidget::loadAttendanceForCourse(int courseId)
 {
     // Tabloyu temizle
-    ui->attendanceTable->setRowCount(0);
-    if (courseId <= 0) return;
-    // 2. Seçili dersin yoklama geçmişini getir
-    QVector<AttendanceSession> sessions = m_dbManager.getAttendanceSessionsForCourse(courseId);
-    int row = 0;
-    for (const auto& session : sessions) {
-        // Bu oturumda öğrenci var mı?
-        QVector<AttendanceRecord> records = m_dbManager.getAttendanceForSession(session.id);
-        bool found = false;
-        QString time;
-        for (const auto& rec : records) {
-            Student studentInfo = m_dbManager.getStudentById(m_student.id);
-            if (!studentInfo.studentNumber.isEmpty() && rec.studentNumber == studentInfo.studentNumber) {
-                found = true;
-                time = rec.time;
-                break;
-            }
-        }
-        ui->attendanceTable->insertRow(row);
-        ui->attendanceTable->setItem(row, 0, new QTableWidgetItem(session.courseName));
-        ui->attendanceTable->setItem(row, 1, new QTableWidgetItem(session.startTime.toString("yyyy-MM-dd")));
-        ui->attendanceTable->setItem(row, 2, new QTableWidgetItem(found ? "Var" : "Yok"));
-        ui->attendanceTable->setItem(row, 3, new QTableWidgetItem(found ? time : "-"));
-        row++;
+    m_attendanceModel->clear();
+    int loadId = ++m_attendanceLoadId;
+    if (courseId <= 0) {
+        TableHelper::setLoading(ui->attendanceTable, false);
+        return;
     }
-    ui->attendanceTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    // 2. Seçili dersin oturumları ve öğrencinin durumu tek sorguda, arka planda gelir
+    TableHelper::setLoading(ui->attendanceTable, true);
+    int studentId = m_student.id;
+    m_dbManager.runAsync([studentId, courseId](DatabaseManager& db) {
+        return db.getStudentAttendanceForCourse(studentId, courseId);
+    }).then(this, [this, loadId](QVector<StudentAttendanceEntry> entries) {
+        // Bu arada başka bir ders seçildiyse eski sonuç atılır
+        if (loadId != m_attendanceLoadId) return;
+        m_attendanceModel->setRecords(entries);
+        TableHelper::setLoading(ui->attendanceTable, false);
+        ui->attendanceTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    });
 } 
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <QWidget>
 #include "databasemanager.h"
+#include "recordtablemodel.h"
 
 namespace Ui {
 class StudentWidget;
@@ -22,6 +23,8 @@ private:
     Ui::StudentWidget* ui;
     User m_student;
     DatabaseManager& m_dbManager;
+    RecordTableModel<StudentAttendanceEntry>* m_attendanceModel;
+    int m_attendanceLoadId = 0; // Son başlatılan arka plan yüklemesi
     void loadAttendanceHistory();
     void loadAttendanceForCourse(int courseId);
 };
@@ -1,14 +1,13 @@
 #include "tablehelper.h"
 #include <QFontMetrics>
 #include <QScrollBar>
+#include <QHash>
+#include <QAbstractItemDelegate>
+#include <QStyleOptionViewItem>
+#include <QLabel>
 
-void TableHelper::setupDynamicTable(QTableWidget* table, const QStringList& headers, 
-                                   bool stretchLastColumn, bool alternateColors)
+void TableHelper::setupDynamicTable(QTableView* table, bool stretchLastColumn, bool alternateColors)
 {
-    // Sütun sayısını ayarla
-    table->setColumnCount(headers.count());
-    table->setHorizontalHeaderLabels(headers);
-    
     // Header'ı ayarla
     QHeaderView* header = table->horizontalHeader();
     header->setStretchLastSection(stretchLastColumn);
@@ -31,102 +30,122 @@ void TableHelper::setupDynamicTable(QTableWidget* table, const QStringList& head
     applyModernStyle(table);
 }
 
-void TableHelper::resizeColumnsToContent(QTableWidget* table)
+void TableHelper::resizeColumnsToContent(QTableView* table)
 {
     if (!table) return;
     
-    table->resizeColumnsToContents();
+    QAbstractItemModel* model = table->model();
+    if (!model) return;
+    
+    // Tüm satırları ölçmek yerine en fazla kSampleRows satır eşit aralıklarla örneklenir;
+    // sonradan eklenen satırlar growColumnsForRow ile sütunu genişletir
+    int rowCount = model->rowCount();
+    int step = qMax(1, rowCount / kSampleRows);
     
-    // Minimum genişlikleri ayarla
-    for (int i = 0; i < table->columnCount(); ++i) {
-        int currentWidth = table->columnWidth(i);
-        int minWidth = 80; // Minimum genişlik
+    QFontMetrics fm(table->font());
+    for (int i = 0; i < model->columnCount(); ++i) {
+        int minWidth = kMinColumnWidth; // Minimum genişlik
         
         // Başlık genişliğini kontrol et
-        QTableWidgetItem* headerItem = table->horizontalHeaderItem(i);
-        if (headerItem) {
-            QFontMetrics fm(table->font());
-            int headerWidth = fm.horizontalAdvance(headerItem->text()) + 20;
-            minWidth = qMax(minWidth, headerWidth);
+        QString headerText = model->headerData(i, Qt::Horizontal).toString();
+        if (!headerText.isEmpty()) {
+            minWidth = qMax(minWidth, textWidth(table, fm, headerText) + kCellPadding);
         }
         
-        // İçerik genişliğini kontrol et
+        // İçerik genişliğini kontrol et (son satır her zaman örneğe dahil)
         int maxContentWidth = minWidth;
-        for (int row = 0; row < table->rowCount(); ++row) {
-            QTableWidgetItem* item = table->item(row, i);
-            if (item) {
-                QFontMetrics fm(table->font());
-                int itemWidth = fm.horizontalAdvance(item->text()) + 20;
-                maxContentWidth = qMax(maxContentWidth, itemWidth);
-            }
+        for (int row = 0; row < rowCount && maxContentWidth < kMaxColumnWidth; row += step) {
+            maxContentWidth = qMax(maxContentWidth, cellWidth(table, fm, model->index(row, i)));
+        }
+        if (rowCount > 0) {
+            maxContentWidth = qMax(maxContentWidth, cellWidth(table, fm, model->index(rowCount - 1, i)));
         }
         
         // Maksimum genişliği sınırla
-        int maxWidth = 300;
-        int finalWidth = qMin(qMax(currentWidth, maxContentWidth), maxWidth);
-        
-        table->setColumnWidth(i, finalWidth);
+        table->setColumnWidth(i, qMin(maxContentWidth, kMaxColumnWidth));
     }
     
     // Tablo genişliğini ayarla
     table->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
 }
 
-void TableHelper::makeReadOnly(QTableWidget* table)
+void TableHelper::growColumnsForRow(QTableView* table, int row)
 {
-    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    QAbstractItemModel* model = table ? table->model() : nullptr;
+    if (!model || row < 0 || row >= model->rowCount()) return;
+    
+    QFontMetrics fm(table->font());
+    for (int i = 0; i < model->columnCount(); ++i) {
+        // resizeColumnsToContent ile aynı sınırlar
+        int itemWidth = qMin(cellWidth(table, fm, model->index(row, i)), kMaxColumnWidth);
+        if (itemWidth > table->columnWidth(i)) {
+            table->setColumnWidth(i, itemWidth);
+        }
+    }
 }
 
-void TableHelper::clearTable(QTableWidget* table)
+int TableHelper::cellWidth(QTableView* table, const QFontMetrics& fm, const QModelIndex& index)
 {
-    table->clearContents();
-    table->setRowCount(0);
+    // Buton çizen sütun delegate'leri (ActionButtonDelegate) kendi boyut ipucunu kullanır
+    if (QAbstractItemDelegate* delegate = table->itemDelegateForColumn(index.column())) {
+        QStyleOptionViewItem option;
+        option.font = table->font();
+        return delegate->sizeHint(option, index).width();
+    }
+    
+    QString text = index.data().toString();
+    return text.isEmpty() ? 0 : textWidth(table, fm, text) + kCellPadding;
 }
 
-void TableHelper::addRow(QTableWidget* table, const QStringList& data, const QVariant& userData)
+int TableHelper::textWidth(QTableView* table, const QFontMetrics& fm, const QString& text)
 {
-    int row = table->rowCount();
-    table->insertRow(row);
+    // Durum, tarih, öğretmen adı gibi tekrar eden metinler yazı tipi başına bir kez ölçülür.
+    // Tablolar yalnızca arayüz thread'inde boyutlandırıldığı için önbellek paylaşılır.
+    static QHash<QString, QHash<QString, int>> cache;
     
-    for (int col = 0; col < data.count() && col < table->columnCount(); ++col) {
-        QTableWidgetItem* item = new QTableWidgetItem(data[col]);
-        item->setFlags(item->flags() & ~Qt::ItemIsEditable);
-        table->setItem(row, col, item);
+    QHash<QString, int>& widths = cache[table->font().key()];
+    auto it = widths.constFind(text);
+    if (it != widths.constEnd()) {
+        return it.value();
     }
     
-    // User data'yı ilk sütuna ekle
-    if (userData.isValid() && table->columnCount() > 0) {
-        QTableWidgetItem* firstItem = table->item(row, 0);
-        if (firstItem) {
-            firstItem->setData(Qt::UserRole, userData);
-        }
+    if (widths.size() >= kMaxCachedWidths) {
+        widths.clear();
     }
+    int width = fm.horizontalAdvance(text);
+    widths.insert(text, width);
+    return width;
 }
 
-void TableHelper::addRow(QTableWidget* table, const QVariantList& data, const QVariant& userData)
+void TableHelper::setLoading(QTableView* table, bool loading)
 {
-    int row = table->rowCount();
-    table->insertRow(row);
+    if (!table) return;
     
-    for (int col = 0; col < data.count() && col < table->columnCount(); ++col) {
-        QTableWidgetItem* item = new QTableWidgetItem(data[col].toString());
-        item->setFlags(item->flags() & ~Qt::ItemIsEditable);
-        table->setItem(row, col, item);
+    QLabel* label = table->viewport()->findChild<QLabel*>("tableLoadingLabel", Qt::FindDirectChildrenOnly);
+    if (loading && !label) {
+        label = new QLabel("Yükleniyor...", table->viewport());
+        label->setObjectName("tableLoadingLabel");
+        label->setAlignment(Qt::AlignCenter);
+        label->setStyleSheet("QLabel#tableLoadingLabel { color: #7f8c8d; font-size: 11pt; font-weight: bold; background: transparent; }");
+        label->setAttribute(Qt::WA_TransparentForMouseEvents);
     }
     
-    // User data'yı ilk sütuna ekle
-    if (userData.isValid() && table->columnCount() > 0) {
-        QTableWidgetItem* firstItem = table->item(row, 0);
-        if (firstItem) {
-            firstItem->setData(Qt::UserRole, userData);
-        }
+    table->setEnabled(!loading);
+    if (label) {
+        label->setGeometry(table->viewport()->rect());
+        label->setVisible(loading);
     }
 }
 
-void TableHelper::applyModernStyle(QTableWidget* table)
+void TableHelper::makeReadOnly(QTableView* table)
+{
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+}
+
+void TableHelper::applyModernStyle(QTableView* table)
 {
     QString styleSheet = R"(
-        QTableWidget {
+        QTableView {
             background: white;
             alternate-background-color: #f8f9fa;
             border: 2px solid #bdc3c7;
@@ -138,18 +157,18 @@ void TableHelper::applyModernStyle(QTableWidget* table)
             font-family: 'Segoe UI', Arial, sans-serif;
         }
 
-        QTableWidget::item {
+        QTableView::item {
             padding: 8px;
             border-bottom: 1px solid #ecf0f1;
         }
 
-        QTableWidget::item:selected {
+        QTableView::item:selected {
             background: qlineargradient(x1:0, y1:0, x2:0, y2:1,
                                        stop:0 #3498db, stop:1 #2980b9);
             color: white;
         }
 
-        QTableWidget::item:hover {
+        QTableView::item:hover {
             background: #e8f4fd;
         }
 
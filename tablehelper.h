@@ -1,7 +1,7 @@
 #ifndef TABLEHELPER_H
 #define TABLEHELPER_H
 
-#include <QTableWidget>
+#include <QTableView>
 #include <QHeaderView>
 #include <QApplication>
 #include <QScreen>
@@ -9,32 +9,34 @@
 class TableHelper
 {
 public:
-    // Tabloyu dinamik boyutlandır
-    static void setupDynamicTable(QTableWidget* table, const QStringList& headers, 
-                                 bool stretchLastColumn = true, bool alternateColors = true);
+    // Tabloyu dinamik boyutlandır (sütun başlıkları tablonun modelinden gelir)
+    static void setupDynamicTable(QTableView* table, bool stretchLastColumn = true,
+                                 bool alternateColors = true);
     
-    // Sütunları içeriğe göre boyutlandır
-    static void resizeColumnsToContent(QTableWidget* table);
+    // Sütunları içeriğe göre boyutlandır (büyük tablolarda satırlar örneklenir)
+    static void resizeColumnsToContent(QTableView* table);
     
-    // Tabloyu salt okunur yap
-    static void makeReadOnly(QTableWidget* table);
-    
-    // Tabloyu temizle
-    static void clearTable(QTableWidget* table);
+    // Sütunları sadece verilen satıra göre genişletir (tüm tabloyu taramaz)
+    static void growColumnsForRow(QTableView* table, int row);
     
-    // Satır ekle
-    static void addRow(QTableWidget* table, const QStringList& data, 
-                      const QVariant& userData = QVariant());
+    // Arka planda veri yüklenirken tabloyu devre dışı bırakır ve üzerinde "Yükleniyor..." gösterir
+    static void setLoading(QTableView* table, bool loading);
     
-    // Satır ekle (QVariant listesi ile)
-    static void addRow(QTableWidget* table, const QVariantList& data, 
-                      const QVariant& userData = QVariant());
+    // Tabloyu salt okunur yap
+    static void makeReadOnly(QTableView* table);
     
     // Tabloyu stil ile güzelleştir
-    static void applyModernStyle(QTableWidget* table);
+    static void applyModernStyle(QTableView* table);
 
 private:
-    static QString getTextWidth(const QString& text);
+    static constexpr int kMinColumnWidth = 80;
+    static constexpr int kMaxColumnWidth = 300;
+    static constexpr int kCellPadding = 20;
+    static constexpr int kSampleRows = 500;       // Genişlik tahmininde ölçülen en fazla satır
+    static constexpr int kMaxCachedWidths = 8192; // Yazı tipi başına önbellekteki metin sayısı
+    
+    static int cellWidth(QTableView* table, const QFontMetrics& fm, const QModelIndex& index);
+    static int textWidth(QTableView* table, const QFontMetrics& fm, const QString& text);
 };
 
 #endif // TABLEHELPER_H 
\ No newline at end of file
@@ -0,0 +1,232 @@
+#include "tapjournal.h"
+#include <QDeadlineTimer>
+#include <QDebug>
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+namespace {
+const char kMagic[4] = {'Y', 'T', 'J', '1'};
+
+struct HeaderLayout {
+    char magic[4];
+    quint32 recordSize;
+    quint64 committedSequence; // Bu sıra numarasına kadar olan kayıtlar veritabanında
+};
+
+// Diskteki kayıt düzeni; alanlar hizalı, dolgu yok
+struct RecordLayout {
+    quint64 sequence;          // 0: boş yuva
+    qint64 monotonicNs;
+    qint64 wallMs;
+    qint32 sessionId;
+    qint32 studentId;
+    quint8 uidLength;
+    quint8 uid[CardUid::kMaxLength];
+    quint8 reserved;
+    quint32 crc;               // Önceki alanların CRC32'si
+};
+static_assert(sizeof(RecordLayout) == TapJournal::kRecordSize, "Günlük kayıt boyutu değişmemeli");
+static_assert(sizeof(HeaderLayout) <= TapJournal::kHeaderSize, "Günlük başlığı sığmıyor");
+
+const int kCrcOffset = offsetof(RecordLayout, crc);
+
+quint32 crc32(const uchar* data, int size)
+{
+    static const std::array<quint32, 256> table = [] {
+        std::array<quint32, 256> result{};
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 c = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            result[i] = c;
+        }
+        return result;
+    }();
+
+    quint32 crc = 0xFFFFFFFFu;
+    for (int i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+}
+
+TapJournal::TapJournal(const QString& path)
+    : m_file(path)
+    , m_map(nullptr)
+    , m_mappedSize(0)
+    , m_writeOffset(kHeaderSize)
+    , m_nextSequence(1)
+{
+}
+
+TapJournal::~TapJournal()
+{
+    close();
+}
+
+bool TapJournal::open()
+{
+    if (isOpen()) return true;
+
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        qDebug() << "Okutma günlüğü açılamadı:" << m_file.errorString();
+        return false;
+    }
+
+    qint64 minimumSize = kHeaderSize + qint64(kInitialRecords) * kRecordSize;
+    bool created = m_file.size() < kHeaderSize;
+    if (!mapFile(qMax(m_file.size(), minimumSize))) {
+        m_file.close();
+        return false;
+    }
+
+    HeaderLayout header;
+    std::memcpy(&header, m_map, sizeof(header));
+    if (created) {
+        initialize();
+    } else if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.recordSize != kRecordSize) {
+        qDebug() << "Okutma günlüğünün biçimi tanınmadı, sıfırlanıyor:" << m_file.fileName();
+        initialize();
+    } else {
+        scan();
+    }
+    return true;
+}
+
+void TapJournal::close()
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+        m_mappedSize = 0;
+    }
+    m_file.close();
+}
+
+bool TapJournal::mapFile(qint64 size)
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    if (m_file.size() != size && !m_file.resize(size)) {
+        qDebug() << "Okutma günlüğü boyutlandırılamadı:" << m_file.errorString();
+        return false;
+    }
+    m_map = m_file.map(0, size);
+    if (!m_map) {
+        qDebug() << "Okutma günlüğü belleğe eşlenemedi:" << m_file.errorString();
+        return false;
+    }
+    m_mappedSize = size;
+    return true;
+}
+
+bool TapJournal::grow()
+{
+    m_stats.remaps++;
+    return mapFile(kHeaderSize + (m_mappedSize - kHeaderSize) * 2);
+}
+
+void TapJournal::initialize()
+{
+    std::memset(m_map, 0, m_mappedSize);
+    HeaderLayout header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.recordSize = kRecordSize;
+    header.committedSequence = 0;
+    std::memcpy(m_map, &header, sizeof(header));
+    m_writeOffset = kHeaderSize;
+    m_nextSequence = 1;
+}
+
+void TapJournal::scan()
+{
+    HeaderLayout header;
+    std::memcpy(&header, m_map, sizeof(header));
+
+    // Başa sarıldıktan sonra yazılan kayıtlar committedSequence'tan büyük ve artan sıradadır;
+    // ilk boş, bozuk ya da eski kayıtta durulur
+    quint64 lastSequence = header.committedSequence;
+    qint64 offset = kHeaderSize;
+    while (offset + kRecordSize <= m_mappedSize) {
+        RecordLayout record;
+        std::memcpy(&record, m_map + offset, kRecordSize);
+        if (record.sequence <= lastSequence
+            || record.crc != crc32(m_map + offset, kCrcOffset)
+            || record.uidLength > CardUid::kMaxLength) {
+            break;
+        }
+        lastSequence = record.sequence;
+        offset += kRecordSize;
+    }
+    m_writeOffset = offset;
+    m_nextSequence = qint64(lastSequence) + 1;
+}
+
+bool TapJournal::append(int sessionId, int studentId, const CardUid& uid, qint64 wallMs)
+{
+    if (!isOpen()) return false;
+
+    qint64 startNs = QDeadlineTimer::current(Qt::PreciseTimer).deadlineNSecs();
+    if (m_writeOffset + kRecordSize > m_mappedSize && !grow()) {
+        return false;
+    }
+
+    RecordLayout record{};
+    record.sequence = m_nextSequence++;
+    record.monotonicNs = startNs;
+    record.wallMs = wallMs;
+    record.sessionId = sessionId;
+    record.studentId = studentId;
+    record.uidLength = static_cast<quint8>(uid.length());
+    std::memcpy(record.uid, uid.constData(), CardUid::kMaxLength);
+    record.crc = crc32(reinterpret_cast<const uchar*>(&record), kCrcOffset);
+
+    std::memcpy(m_map + m_writeOffset, &record, kRecordSize);
+    m_writeOffset += kRecordSize;
+
+    qint64 elapsedNs = QDeadlineTimer::current(Qt::PreciseTimer).deadlineNSecs() - startNs;
+    m_stats.appends++;
+    m_stats.totalAppendNs += elapsedNs;
+    m_stats.maxAppendNs = qMax(m_stats.maxAppendNs, elapsedNs);
+    return true;
+}
+
+QVector<TapJournalEntry> TapJournal::pendingEntries() const
+{
+    QVector<TapJournalEntry> entries;
+    if (!isOpen()) return entries;
+
+    entries.reserve(pendingCount());
+    for (qint64 offset = kHeaderSize; offset < m_writeOffset; offset += kRecordSize) {
+        RecordLayout record;
+        std::memcpy(&record, m_map + offset, kRecordSize);
+        entries.append({qint64(record.sequence), record.monotonicNs, record.wallMs,
+                        record.sessionId, record.studentId,
+                        CardUid::fromBytes(reinterpret_cast<const char*>(record.uid), record.uidLength)});
+    }
+    return entries;
+}
+
+void TapJournal::compact()
+{
+    if (!isOpen() || m_writeOffset == kHeaderSize) return;
+
+    // Önce filigran ilerletilir; arada çökülürse eski kayıtlar zaten atlanır
+    HeaderLayout header;
+    std::memcpy(&header, m_map, sizeof(header));
+    header.committedSequence = quint64(m_nextSequence - 1);
+    std::memcpy(m_map, &header, sizeof(header));
+    m_writeOffset = kHeaderSize;
+    m_stats.compactions++;
+
+    // Yoğun bir derste büyüyen dosya başlangıç boyutuna döndürülür
+    qint64 initialSize = kHeaderSize + qint64(kInitialRecords) * kRecordSize;
+    if (m_mappedSize > initialSize * 4) {
+        mapFile(initialSize);
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef TAPJOURNAL_H
+#define TAPJOURNAL_H
+
+#include <QFile>
+#include <QVector>
+#include <QString>
+#include "carduid.h"
+
+struct TapJournalEntry {
+    qint64 sequence;
+    qint64 monotonicNs;  // Okutma anı, monoton saat
+    qint64 wallMs;       // attendanceRecords.time için duvar saati
+    int sessionId;
+    int studentId;
+    CardUid uid;
+};
+
+struct TapJournalStats {
+    qint64 appends = 0;
+    qint64 totalAppendNs = 0;
+    qint64 maxAppendNs = 0;
+    qint64 remaps = 0;       // Dosya büyütülüp yeniden eşlendi
+    qint64 compactions = 0;
+
+    double appendsPerSecond() const { return totalAppendNs > 0 ? appends * 1e9 / totalAppendNs : 0.0; }
+};
+
+// Kabul edilen her okutmanın veritabanına yazılmadan önce eklendiği, belleğe eşlenmiş
+// (mmap) sabit kayıt boyutlu günlük. Her kayıt CRC32 ile korunur; açılışta ilk bozuk
+// ya da yarım kayda kadar olanlar tekrar oynatılır. Eşlenmiş sayfalar işletim
+// sisteminde kaldığı için uygulama çökse de kayıtlar kaybolmaz.
+// Tüm kayıtlar commit edildiğinde günlük O(1) ile başa sarılır: başlıktaki
+// committedSeq ilerletilir, eski kayıtlar üzerine yazılır.
+class TapJournal
+{
+public:
+    static constexpr int kRecordSize = 48;
+    static constexpr int kHeaderSize = 64;
+    static constexpr int kInitialRecords = 4096;
+
+    explicit TapJournal(const QString& path);
+    ~TapJournal();
+
+    bool open();
+    void close();
+    bool isOpen() const { return m_map != nullptr; }
+    QString path() const { return m_file.fileName(); }
+
+    bool append(int sessionId, int studentId, const CardUid& uid, qint64 wallMs);
+
+    // Son sıkıştırmadan sonra eklenmiş sağlam kayıtlar, sırasıyla
+    QVector<TapJournalEntry> pendingEntries() const;
+    int pendingCount() const { return (m_writeOffset - kHeaderSize) / kRecordSize; }
+
+    // Günlükteki tüm kayıtlar veritabanına yazıldı
+    void compact();
+
+    const TapJournalStats& stats() const { return m_stats; }
+
+private:
+    bool mapFile(qint64 size);
+    bool grow();
+    void initialize();
+    void scan();
+
+    QFile m_file;
+    uchar* m_map;
+    qint64 m_mappedSize;
+    qint64 m_writeOffset;
+    qint64 m_nextSequence;
+    TapJournalStats m_stats;
+};
+
+#endif // TAPJOURNAL_H
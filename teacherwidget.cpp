@@ -3,7 +3,7 @@
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QTabWidget>
-#include <QTableWidget>
+#include <QTableView>
 #include <QPushButton>
 #include <QGroupBox>
 #include <QLabel>
@@ -16,6 +16,8 @@
 #include <QTextEdit>
 #include <QComboBox>
 #include "tablehelper.h"
+#include "actionbuttondelegate.h"
+#include "lazytabloader.h"
 #include <QDebug>
 #include <QBrush>
 #include <QColor>
@@ -24,6 +26,22 @@
 #include <QSerialPort>
 #include <QSerialPortInfo>
 
+namespace {
+const int kHistoryActionsColumn = 5;
+const int kHistoryPageSize = 100; // Kaydırdıkça yüklenen geçmiş oturumu
+
+// Yoklamaya katılan öğrenciler tablosu (anlık yoklama ve geçmiş detayı)
+QVector<RecordTableModel<AttendanceRecord>::Column> attendanceRecordColumns(const QString& timeHeader)
+{
+    return {
+        {"Öğrenci No", [](const AttendanceRecord& record) { return record.studentNumber; }},
+        {"Ad", [](const AttendanceRecord& record) { return record.firstName; }},
+        {"Soyad", [](const AttendanceRecord& record) { return record.lastName; }},
+        {timeHeader, [](const AttendanceRecord& record) { return record.time; }}
+    };
+}
+}
+
 TeacherWidget::TeacherWidget(DatabaseManager& dbManager, const User& user, QWidget* parent)
     : QWidget(parent)
     , ui(new Ui::TeacherWidget)
@@ -63,7 +81,58 @@ void TeacherWidget::setupUI()
 
 void TeacherWidget::setupTableHeaders()
 {
-    // UI dosyasında zaten tanımlanmış, sadece özellikleri ayarla
+    // Sıralama açılmadan önce modeller bağlanır; görünüm sıralamayı modele uygular
+    m_currentAttendanceModel = new RecordTableModel<AttendanceRecord>(
+        attendanceRecordColumns("Geliş Saati"), this);
+    ui->currentAttendanceTable->setModel(m_currentAttendanceModel);
+    
+    m_historyModel = new RecordTableModel<AttendanceSession>({
+        {"Başlık", [](const AttendanceSession& session) { return session.title; }},
+        {"Ders", [](const AttendanceSession& session) { return session.courseName; }},
+        {"Tarih", [](const AttendanceSession& session) { return session.startTime.toString("dd.MM.yyyy HH:mm"); }},
+        {"Durum", [](const AttendanceSession& session) { return QString(session.isActive ? "Aktif" : "Tamamlandı"); }},
+        {"Öğrenci Sayısı", [](const AttendanceSession& session) { return QString::number(session.studentCount); }},
+        {"İşlemler", nullptr}
+    }, this);
+    ui->historyTable->setModel(m_historyModel);
+    // Tablo sona yaklaşınca sonraki sayfa istenir
+    m_historyModel->setFetchMoreFunction([this]() {
+        fetchHistoryPage(m_historyLoadId);
+    });
+    
+    // İşlemler butonu - sadece tamamlanmış yoklamalar için, satır başına widget oluşturmadan çizilir
+    auto* historyActions = new ActionButtonDelegate({
+        {"Silme İsteği", QColor("#e74c3c"), QColor("#ec7063"), "Bu yoklama için silme isteği gönder"}
+    }, ui->historyTable);
+    historyActions->setVisibleFunction([this](const QModelIndex& index) {
+        return !m_historyModel->record(index.row()).isActive;
+    });
+    ui->historyTable->setItemDelegateForColumn(kHistoryActionsColumn, historyActions);
+    connect(historyActions, &ActionButtonDelegate::buttonClicked, this,
+            [this](const QPersistentModelIndex& index, int) {
+        if (!index.isValid()) return; // Geçmiş bu arada yenilendi
+        const AttendanceSession& session = m_historyModel->record(index.row());
+        requestDeleteAttendance(session.id, session.title);
+    });
+    
+    // Durum sütunu aktif yoklamaya göre çizilir
+    m_enrolledStudentsModel = new RecordTableModel<SessionRosterEntry>({
+        {"Öğrenci No", [](const SessionRosterEntry& entry) { return entry.student.studentNumber; }},
+        {"Ad", [](const SessionRosterEntry& entry) { return entry.student.firstName; }},
+        {"Soyad", [](const SessionRosterEntry& entry) { return entry.student.lastName; }},
+        {"Durum", [this](const SessionRosterEntry& entry) -> QVariant {
+            if (m_currentSessionId <= 0) return QString("-");
+            return entry.present ? "Var (" + entry.time + ")" : QString("Yok");
+        }, [this](const SessionRosterEntry& entry) -> QVariant {
+            if (m_currentSessionId <= 0) return QBrush(QColor("#7f8c8d")); // Gri renk
+            return QBrush(QColor(entry.present ? "#27ae60" : "#e74c3c")); // Yeşil / kırmızı
+        }}
+    }, this);
+    m_enrolledStudentsModel->setKeyFunction([](const SessionRosterEntry& entry) {
+        return entry.student.studentNumber;
+    });
+    ui->enrolledStudentsTable->setModel(m_enrolledStudentsModel);
+    
     ui->currentAttendanceTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
     ui->currentAttendanceTable->setSelectionBehavior(QAbstractItemView::SelectRows);
     ui->currentAttendanceTable->setAlternatingRowColors(true);
@@ -80,13 +149,26 @@ void TeacherWidget::setupTableHeaders()
     ui->enrolledStudentsTable->setSortingEnabled(true);
     
     // Çift tıklama ile detay görüntüleme
-    connect(ui->historyTable, &QTableWidget::cellDoubleClicked, 
+    connect(ui->historyTable, &QTableView::doubleClicked, 
             this, &TeacherWidget::onHistoryTableDoubleClicked);
 }
 
 void TeacherWidget::setupConnections()
 {
-    // Ders seçimi değiştiğinde buton durumunu güncelle ve öğrenci listesini yükle
+    // Sekmeler girişte değil ilk açıldıklarında yüklenir; sekmeye geri dönmek sorgu çalıştırmaz,
+    // veri değiştiğinde sekme eski işaretlenir. ComboBox sinyalleri de bu yükleyiciyi kullanır.
+    m_tabLoader = new LazyTabLoader(ui->tabWidget);
+    m_tabLoader->setLoader(ui->historyTab, [this]() {
+        loadAttendanceHistory(ui->historyCourseComboBox->currentData().toInt());
+    });
+    m_tabLoader->setLoader(ui->studentsTab, [this]() {
+        int courseId = ui->studentsCourseComboBox->currentData().toInt();
+        if (courseId > 0) {
+            loadEnrolledStudents(courseId);
+        }
+    });
+    
+    // Ders seçimi değiştiğinde buton durumunu güncelle
     connect(ui->courseComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &TeacherWidget::onCourseChanged);
     
@@ -105,22 +187,6 @@ void TeacherWidget::setupConnections()
     connect(ui->titleEdit, &QLineEdit::textChanged,
             this, &TeacherWidget::updateStartButtonState);
     
-    // Tab değiştiğinde öğrenci listesini güncelle
-    connect(ui->tabWidget, &QTabWidget::currentChanged, [this](int index) {
-        // Öğrenciler tabına geçildiğinde
-        if (index == 2) { // 2 = studentsTab
-            int courseId = ui->studentsCourseComboBox->currentData().toInt();
-            if (courseId > 0) {
-                loadEnrolledStudents(courseId);
-            }
-        }
-        // Geçmiş tabına geçildiğinde
-        else if (index == 1) { // 1 = historyTab
-            int courseId = ui->historyCourseComboBox->currentData().toInt();
-            loadAttendanceHistory(courseId);
-        }
-    });
-    
     // Buton bağlantıları
     connect(ui->startButton, &QPushButton::clicked, this, &TeacherWidget::onStartAttendanceClicked);
     connect(ui->endButton, &QPushButton::clicked, this, &TeacherWidget::onEndAttendanceClicked);
@@ -137,18 +203,11 @@ void TeacherWidget::loadData()
 {
     loadCourses();
     
-    // Aktif yoklama kontrolü
-    m_currentSessionId = m_dbManager.getActiveSessionId(m_currentUser.id);
+    // Aktif yoklama kontrolü (yoklama sekmesi ve kart okuma buna bağlı, hemen yapılır)
     checkActiveAttendance();
     
-    // Varsayılan olarak ilk dersi seç
-    if (ui->courseComboBox->count() > 0) {
-        int courseId = ui->courseComboBox->itemData(0).toInt();
-        loadEnrolledStudents(courseId);
-    }
-    
-    // Yoklama geçmişini yükle
-    loadAttendanceHistory(-1); // Tüm derslerin yoklama geçmişini yükle
+    // Açık sekme şimdi, geçmiş ve öğrenciler sekmeleri ilk açıldıklarında yüklenir
+    m_tabLoader->start();
 }
 
 void TeacherWidget::loadCourses()
@@ -182,69 +241,41 @@ void TeacherWidget::loadAttendanceHistory(int courseId)
 {
     qDebug() << ">>> loadAttendanceHistory çağrıldı, öğretmen ID:" << m_currentUser.id << "Ders ID:" << courseId;
     
-    QVector<AttendanceSession> sessions;
-    
-    if (courseId > 0) {
-        // Belirli bir ders için yoklama geçmişini al
-        sessions = m_dbManager.getAttendanceSessionsForCourse(courseId);
-    } else {
-        // Tüm dersler için yoklama geçmişini al
-        sessions = m_dbManager.getTeacherAttendanceHistory(m_currentUser.id);
-    }
-    
-    ui->historyTable->setRowCount(sessions.count());
+    // Geçmiş arka planda ve sayfa sayfa yüklenir; yoklama sırasında kart okutmaları beklemez
+    TableHelper::setLoading(ui->historyTable, true);
+    int loadId = ++m_historyLoadId;
+    m_historyCourseId = courseId;
+    m_historyCursor = SessionPageCursor();
+    m_historyModel->clear();
+    fetchHistoryPage(loadId);
+}
+
+void TeacherWidget::fetchHistoryPage(int loadId)
+{
+    int courseId = m_historyCourseId;
+    int teacherId = m_currentUser.id;
+    SessionPageCursor cursor = m_historyCursor;
     
-    for (int i = 0; i < sessions.count(); ++i) {
-        const auto& session = sessions[i];
-        
-        QTableWidgetItem* titleItem = new QTableWidgetItem(session.title);
-        titleItem->setData(Qt::UserRole, session.id);
-        ui->historyTable->setItem(i, 0, titleItem);
-        
-        QTableWidgetItem* courseItem = new QTableWidgetItem(session.courseName);
-        ui->historyTable->setItem(i, 1, courseItem);
-        
-        QTableWidgetItem* dateItem = new QTableWidgetItem(session.startTime.toString("dd.MM.yyyy HH:mm"));
-        ui->historyTable->setItem(i, 2, dateItem);
-        
-        QTableWidgetItem* statusItem = new QTableWidgetItem(session.isActive ? "Aktif" : "Tamamlandı");
-        ui->historyTable->setItem(i, 3, statusItem);
-        
-        QTableWidgetItem* countItem = new QTableWidgetItem(QString::number(session.studentCount));
-        ui->historyTable->setItem(i, 4, countItem);
-        
-        // İşlemler butonu - sadece tamamlanmış yoklamalar için
-        if (!session.isActive) {
-            QWidget* buttonWidget = new QWidget();
-            buttonWidget->setStyleSheet("QWidget { background: transparent; }");
-            QHBoxLayout* buttonLayout = new QHBoxLayout(buttonWidget);
-            buttonLayout->setContentsMargins(2, 2, 2, 2);
-            buttonLayout->setSpacing(0);
-            
-            QPushButton* deleteButton = new QPushButton("Silme İsteği");
-            deleteButton->setStyleSheet("QPushButton { background: #e74c3c; color: white; border: none; padding: 4px 10px; border-radius: 8px; font-size: 10pt; font-weight: bold; } QPushButton:hover { background: #ec7063; }");
-            deleteButton->setToolTip("Bu yoklama için silme isteği gönder");
-            connect(deleteButton, &QPushButton::clicked, [this, session]() {
-                requestDeleteAttendance(session.id, session.title);
-            });
-            
-            buttonLayout->addWidget(deleteButton);
-            buttonLayout->addStretch();
-            buttonLayout->setContentsMargins(4, 4, 4, 4);
-            buttonLayout->setSpacing(6);
-            
-            ui->historyTable->setCellWidget(i, 5, buttonWidget);
-        } else {
-            // Aktif yoklamalar için boş widget
-            QWidget* emptyWidget = new QWidget();
-            emptyWidget->setStyleSheet("QWidget { background: transparent; }");
-            ui->historyTable->setCellWidget(i, 5, emptyWidget);
+    m_dbManager.runAsync([courseId, teacherId, cursor](DatabaseManager& db) {
+        if (courseId > 0) {
+            // Belirli bir ders için yoklama geçmişini al
+            return db.getAttendanceSessionsForCoursePage(courseId, cursor, kHistoryPageSize);
         }
-    }
-    
-    // Tabloyu esnek yap
-    ui->historyTable->resizeColumnsToContents();
-    ui->historyTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+        // Tüm dersler için yoklama geçmişini al
+        return db.getTeacherAttendanceHistoryPage(teacherId, cursor, kHistoryPageSize);
+    }).then(this, [this, loadId](SessionPage<AttendanceSession> page) {
+        // Bu arada başka bir ders seçildiyse eski sonuç atılır
+        if (loadId != m_historyLoadId) return;
+        bool firstPage = m_historyModel->rowCount() == 0;
+        m_historyCursor = page.next;
+        m_historyModel->appendRecords(page.rows, page.hasMore);
+        if (!firstPage) return;
+        
+        TableHelper::setLoading(ui->historyTable, false);
+        
+        // Tabloyu esnek yap (sütunlar genişliğe yayılır, içerik ölçümü gerekmez)
+        ui->historyTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    });
 }
 
 void TeacherWidget::checkActiveAttendance()
@@ -263,8 +294,8 @@ void TeacherWidget::checkActiveAttendance()
                 }
             }
             
-            // Kayıtlı öğrencileri yükle
-            loadEnrolledStudents(courseId);
+            // Öğrenci durumları aktif yoklamaya göre değişir
+            m_tabLoader->markStale(ui->studentsTab);
         }
         
         // Başlık etiketini güncelle
@@ -319,10 +350,11 @@ void TeacherWidget::onStartAttendanceClicked()
         ui->tabWidget->setCurrentIndex(0);
         
         // Mevcut yoklama tablosunu temizle
-        ui->currentAttendanceTable->setRowCount(0);
+        m_currentAttendanceModel->clear();
         
-        // Kayıtlı öğrencilerin durumunu güncelle
-        loadEnrolledStudents(courseId);
+        // Geçmişte yeni oturum görünür, öğrenci durumları yeni yoklamaya göre çizilir
+        m_tabLoader->markStale(ui->historyTab);
+        m_tabLoader->markStale(ui->studentsTab);
         
         emit attendanceStarted(m_currentSessionId);
         
@@ -349,19 +381,14 @@ void TeacherWidget::onEndAttendanceClicked()
         ui->startButton->setEnabled(true);
         ui->endButton->setEnabled(false);
         
-        // Mevcut ders ID'sini al
-        int courseId = ui->courseComboBox->currentData().toInt();
-        
         m_currentSessionId = -1;
         emit attendanceEnded();
         
         QMessageBox::information(this, "Başarılı", "Yoklama sonlandırıldı!");
-        loadAttendanceHistory(-1); // Geçmişi güncelle
         
-        // Kayıtlı öğrencilerin durumunu güncelle
-        if (courseId > 0) {
-            loadEnrolledStudents(courseId);
-        }
+        // Geçmiş ve öğrenci durumları sekmeler açıldığında güncellenir
+        m_tabLoader->markStale(ui->historyTab);
+        m_tabLoader->markStale(ui->studentsTab);
     } else {
         QMessageBox::critical(this, "Hata", "Yoklama sonlandırılamadı!");
     }
@@ -372,43 +399,46 @@ void TeacherWidget::updateAttendanceList()
     if (m_currentSessionId > 0) {
         loadCurrentAttendanceData();
         
-        // Aktif yoklama varsa ve bir ders seçiliyse, kayıtlı öğrencilerin durumunu da güncelle
-        int courseId = ui->courseComboBox->currentData().toInt();
-        if (courseId > 0) {
-            loadEnrolledStudents(courseId);
-        }
+        // Kayıtlı öğrencilerin durumu da güncellenir (sekme açık değilse açıldığında)
+        m_tabLoader->markStale(ui->studentsTab);
     }
 }
 
+void TeacherWidget::appendAttendanceRecord(const AttendanceRecord& record)
+{
+    if (m_currentSessionId <= 0) return;
+    
+    int row = m_currentAttendanceModel->insertSorted(record);
+    TableHelper::growColumnsForRow(ui->currentAttendanceTable, row);
+    
+    // Kayıtlı öğrenciler tablosunda sadece öğrencinin satırı değişir
+    int enrolledRow = m_enrolledStudentsModel->rowForKey(record.studentNumber);
+    if (enrolledRow >= 0) {
+        SessionRosterEntry entry = m_enrolledStudentsModel->record(enrolledRow);
+        entry.present = true;
+        entry.time = record.time;
+        m_enrolledStudentsModel->updateRecord(enrolledRow, entry);
+    }
+    
+    // Geçmişteki öğrenci sayısı değişti; her okutmada tabloyu sıfırlamamak için
+    // geçmiş sadece bir sonraki açılışında yenilenir
+    m_tabLoader->markStale(ui->historyTab, false);
+}
+
 void TeacherWidget::loadCurrentAttendanceData()
 {
     if (!ui->currentAttendanceTable || m_currentSessionId <= 0) return;
     
-    QVector<AttendanceRecord> records = m_dbManager.getAttendanceForSession(m_currentSessionId);
-    ui->currentAttendanceTable->setRowCount(records.count());
-    
-    for (int i = 0; i < records.count(); ++i) {
-        const auto& record = records[i];
-        QTableWidgetItem* studentNumberItem = new QTableWidgetItem(record.studentNumber);
-        QTableWidgetItem* firstNameItem = new QTableWidgetItem(record.firstName);
-        QTableWidgetItem* lastNameItem = new QTableWidgetItem(record.lastName);
-        QTableWidgetItem* timeItem = new QTableWidgetItem(record.time);
-        
-        ui->currentAttendanceTable->setItem(i, 0, studentNumberItem);
-        ui->currentAttendanceTable->setItem(i, 1, firstNameItem);
-        ui->currentAttendanceTable->setItem(i, 2, lastNameItem);
-        ui->currentAttendanceTable->setItem(i, 3, timeItem);
-    }
+    m_currentAttendanceModel->setRecords(m_dbManager.getAttendanceForSession(m_currentSessionId));
     
     TableHelper::resizeColumnsToContent(ui->currentAttendanceTable);
 }
 
-void TeacherWidget::onHistoryTableDoubleClicked(int row, int column)
+void TeacherWidget::onHistoryTableDoubleClicked(const QModelIndex& index)
 {
-    QTableWidgetItem* item = ui->historyTable->item(row, 0);
-    if (item) {
-        int sessionId = item->data(Qt::UserRole).toInt();
-        showAttendanceDetails(sessionId);
+    // İşlemler sütunundaki butonlara yapılan çift tıklama detay açmaz
+    if (index.isValid() && index.column() != kHistoryActionsColumn) {
+        showAttendanceDetails(m_historyModel->record(index.row()).id);
     }
 }
 
@@ -423,22 +453,15 @@ void TeacherWidget::showAttendanceDetails(int sessionId)
     
     QVBoxLayout* layout = new QVBoxLayout(dialog);
     
-    QTableWidget* detailTable = new QTableWidget();
-    detailTable->setColumnCount(4);
-    detailTable->setHorizontalHeaderLabels({"Öğrenci No", "Ad", "Soyad", "Geliş Saati"});
+    auto* detailModel = new RecordTableModel<AttendanceRecord>(attendanceRecordColumns("Geliş Saati"), dialog);
+    detailModel->setRecords(records);
+    
+    QTableView* detailTable = new QTableView();
+    detailTable->setModel(detailModel);
     detailTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
     detailTable->setSelectionBehavior(QAbstractItemView::SelectRows);
     detailTable->setAlternatingRowColors(true);
     
-    detailTable->setRowCount(records.count());
-    for (int i = 0; i < records.count(); ++i) {
-        const auto& record = records[i];
-        detailTable->setItem(i, 0, new QTableWidgetItem(record.studentNumber));
-        detailTable->setItem(i, 1, new QTableWidgetItem(record.firstName));
-        detailTable->setItem(i, 2, new QTableWidgetItem(record.lastName));
-        detailTable->setItem(i, 3, new QTableWidgetItem(record.time));
-    }
-    
     TableHelper::resizeColumnsToContent(detailTable);
     layout->addWidget(detailTable);
     
@@ -645,14 +668,6 @@ void TeacherWidget::showChangeEmailDialog()
 void TeacherWidget::onCourseChanged(int index)
 {
     updateStartButtonState();
-    
-    int courseId = ui->courseComboBox->currentData().toInt();
-    if (courseId > 0) {
-        loadEnrolledStudents(courseId);
-    } else {
-        // Ders seçilmediğinde tabloyu temizle
-        ui->enrolledStudentsTable->setRowCount(0);
-    }
 }
 
 void TeacherWidget::loadEnrolledStudents(int courseId)
@@ -661,68 +676,16 @@ void TeacherWidget::loadEnrolledStudents(int courseId)
     
     qDebug() << ">>> loadEnrolledStudents çağrıldı, ders ID:" << courseId;
     
-    QVector<Student> students = m_dbManager.getStudentsForCourse(courseId);
-    ui->enrolledStudentsTable->setRowCount(students.count());
-    
-    // Eğer aktif yoklama varsa, yoklamaya katılan öğrencileri al
-    QVector<AttendanceRecord> attendanceRecords;
-    if (m_currentSessionId > 0) {
-        attendanceRecords = m_dbManager.getAttendanceForSession(m_currentSessionId);
-        qDebug() << ">>> Aktif yoklama ID:" << m_currentSessionId << "Kayıt sayısı:" << attendanceRecords.count();
-    } else {
-        qDebug() << ">>> Aktif yoklama yok";
-    }
-    
-    for (int i = 0; i < students.count(); ++i) {
-        const auto& student = students[i];
-        
-        QTableWidgetItem* studentNumberItem = new QTableWidgetItem(student.studentNumber);
-        ui->enrolledStudentsTable->setItem(i, 0, studentNumberItem);
-        
-        QTableWidgetItem* firstNameItem = new QTableWidgetItem(student.firstName);
-        ui->enrolledStudentsTable->setItem(i, 1, firstNameItem);
-        
-        QTableWidgetItem* lastNameItem = new QTableWidgetItem(student.lastName);
-        ui->enrolledStudentsTable->setItem(i, 2, lastNameItem);
-        
-        // Durum sütunu
-        QTableWidgetItem* statusItem = new QTableWidgetItem();
-        
-        if (m_currentSessionId > 0) {
-            // Öğrencinin yoklamada olup olmadığını kontrol et
-            bool isPresent = false;
-            QString attendanceTime;
-            
-            for (const auto& record : attendanceRecords) {
-                if (record.studentNumber == student.studentNumber) {
-                    isPresent = true;
-                    attendanceTime = record.time;
-                    break;
-                }
-            }
-            
-            if (isPresent) {
-                statusItem->setText("Var (" + attendanceTime + ")");
-                statusItem->setForeground(QBrush(QColor("#27ae60"))); // Yeşil renk
-            } else {
-                statusItem->setText("Yok");
-                statusItem->setForeground(QBrush(QColor("#e74c3c"))); // Kırmızı renk
-            }
-        } else {
-            statusItem->setText("-");
-            statusItem->setForeground(QBrush(QColor("#7f8c8d"))); // Gri renk
-        }
-        
-        ui->enrolledStudentsTable->setItem(i, 3, statusItem);
-    }
+    // Öğrenciler ve aktif yoklamadaki durumları tek sorguda gelir
+    m_enrolledStudentsModel->setRecords(m_dbManager.getCourseRosterWithStatus(courseId, m_currentSessionId));
     
     TableHelper::resizeColumnsToContent(ui->enrolledStudentsTable);
 }
 
 void TeacherWidget::onHistoryCourseChanged(int index)
 {
-    int courseId = ui->historyCourseComboBox->currentData().toInt();
-    loadAttendanceHistory(courseId);
+    // Geçmiş sekmesi açıksa hemen, değilse (ör. dersler yüklenirken) ilk açılışında yüklenir
+    m_tabLoader->markStale(ui->historyTab);
 }
 
 void TeacherWidget::onStudentsCourseChanged(int index)
@@ -732,7 +695,7 @@ void TeacherWidget::onStudentsCourseChanged(int index)
         loadEnrolledStudents(courseId);
         ui->addStudentButton->setEnabled(true);
     } else {
-        ui->enrolledStudentsTable->setRowCount(0);
+        m_enrolledStudentsModel->clear();
         ui->addStudentButton->setEnabled(false);
     }
 }
@@ -863,7 +826,8 @@ void TeacherWidget::showAddStudentDialog(int courseId)
     }
     
     connect(saveButton, &QPushButton::clicked, [this, dialog, cardEdit, studentNumberEdit, firstNameEdit, lastNameEdit, courseId]() {
-        QString cardUID = cardEdit->text().trimmed();
+        QString cardText = cardEdit->text().trimmed();
+        CardUid cardUID = CardUid::fromString(cardText);
         QString studentNumber = studentNumberEdit->text().trimmed();
         QString firstName = firstNameEdit->text().trimmed();
         QString lastName = lastNameEdit->text().trimmed();
@@ -874,8 +838,12 @@ void TeacherWidget::showAddStudentDialog(int courseId)
             QMessageBox::warning(dialog, "Uyarı", "Bu öğrenci numarası ile zaten bir öğrenci kayıtlı!");
             return;
         }
+        if (!cardText.isEmpty() && !cardUID.isValid()) {
+            QMessageBox::warning(dialog, "Uyarı", "Kart UID'si geçersiz! Örnek: 04 A1 B2 C3");
+            return;
+        }
         // Kart UID ile kontrol (boş olabilir)
-        if (!cardUID.isEmpty()) {
+        if (cardUID.isValid()) {
         Student existingStudent = m_dbManager.getStudentByCardUID(cardUID);
         if (existingStudent.id > 0) {
             QString info = QString("Bu öğrenci zaten kayıtlı!\n\nAd: %1\nSoyad: %2\nNumara: %3\n\nBu öğrenciyi bu derse kaydetmek ister misiniz?")
@@ -886,6 +854,7 @@ void TeacherWidget::showAddStudentDialog(int courseId)
             if (reply == QMessageBox::Yes) {
                 bool enrollSuccess = m_dbManager.enrollStudentToCourse(existingStudent.id, courseId, m_currentUser.id);
                 if (enrollSuccess) {
+                    emit studentEnrolled(courseId, existingStudent);
                     QMessageBox::information(dialog, "Başarılı", "Öğrenci bu derse başarıyla kaydedildi.");
                     loadEnrolledStudents(courseId);
                     dialog->accept();
@@ -903,6 +872,7 @@ void TeacherWidget::showAddStudentDialog(int courseId)
         }
         Student student = m_dbManager.addNewStudentAndEnroll(cardUID, studentNumber, firstName, lastName, m_currentUser.id, courseId);
         if (student.id > 0) {
+            emit studentEnrolled(courseId, student);
             QMessageBox::information(dialog, "Başarılı", "Öğrenci başarıyla eklendi ve derse kaydedildi.");
             loadEnrolledStudents(courseId);
             dialog->accept();
@@ -2,18 +2,21 @@
 #define TEACHERWIDGET_H
 
 #include <QWidget>
-#include <QTableWidget>
+#include <QTableView>
 #include <QPushButton>
 #include <QGroupBox>
 #include <QLabel>
 #include <QLineEdit>
 #include <QComboBox>
 #include "databasemanager.h"
+#include "recordtablemodel.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class TeacherWidget; }
 QT_END_NAMESPACE
 
+class LazyTabLoader;
+
 class TeacherWidget : public QWidget
 {
     Q_OBJECT
@@ -23,6 +26,8 @@ public:
     ~TeacherWidget();
 
     void updateAttendanceList();
+    // Yeni yoklama kaydını tabloları yeniden yüklemeden ekler
+    void appendAttendanceRecord(const AttendanceRecord& record);
     int getCurrentCourseIdForEnrollment() const;
     bool tryOpenCardReaderPort(const QString& portName);
 
@@ -31,11 +36,12 @@ signals:
     void attendanceStarted(int sessionId);
     void attendanceEnded();
     void cardScanRequested();
+    void studentEnrolled(int courseId, const Student& student);
 
 private slots:
     void onStartAttendanceClicked();
     void onEndAttendanceClicked();
-    void onHistoryTableDoubleClicked(int row, int column);
+    void onHistoryTableDoubleClicked(const QModelIndex& index);
     void showChangePasswordDialog();
     void showChangeEmailDialog();
     void updateStartButtonState();
@@ -52,6 +58,7 @@ private:
     void loadCourses();
     void loadCurrentAttendanceData();
     void loadAttendanceHistory(int courseId);
+    void fetchHistoryPage(int loadId);
     void loadEnrolledStudents(int courseId);
     void checkActiveAttendance();
     void showAttendanceDetails(int sessionId);
@@ -62,9 +69,9 @@ private:
     DatabaseManager& m_dbManager;
     User m_currentUser;
     int m_currentSessionId;
-    QTableWidget* m_currentAttendanceTable;
-    QTableWidget* m_historyTable;
-    QTableWidget* m_enrolledStudentsTable;
+    QTableView* m_currentAttendanceTable;
+    QTableView* m_historyTable;
+    QTableView* m_enrolledStudentsTable;
     QComboBox* m_courseComboBox;
     QComboBox* m_historyCourseComboBox;
     QComboBox* m_studentsCourseComboBox;
@@ -73,6 +80,14 @@ private:
     QPushButton* m_endButton;
     QPushButton* m_addStudentButton;
     QLabel* m_courseSelectionLabel;
+    RecordTableModel<AttendanceRecord>* m_currentAttendanceModel;
+    RecordTableModel<AttendanceSession>* m_historyModel;
+    // Kayıtlı öğrenciler, satırları öğrenci numarasıyla bulunur
+    RecordTableModel<SessionRosterEntry>* m_enrolledStudentsModel;
+    LazyTabLoader* m_tabLoader = nullptr; // Geçmiş ve öğrenciler sekmeleri ilk açılışta yüklenir
+    int m_historyLoadId = 0; // Son başlatılan arka plan geçmiş yüklemesi
+    int m_historyCourseId = -1; // Geçmişi gösterilen ders, -1 tüm dersler
+    SessionPageCursor m_historyCursor; // Yüklenen son geçmiş satırı
 };
 
 #endif // TEACHERWIDGET_H 
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include <QtTest>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include "sessionroster.h"
+#include "tapjournal.h"
+
+namespace {
+const int kRosterSize = 200;       // Kalabalık bir ders
+const int kTapsPerIteration = 1000;
+const int kJournalTaps = 10000;
+const double kRequiredJournalTapsPerSecond = 10000.0;
+
+// Okuyucudan gelen ham 7 baytlık UID'ler
+QVector<QByteArray> makeRawUids(int count)
+{
+    QRandomGenerator random(42);
+    QVector<QByteArray> uids;
+    uids.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        QByteArray uid(7, '\0');
+        uid[0] = char(0x04);
+        for (int j = 1; j < uid.size(); ++j) {
+            uid[j] = char(random.bounded(256));
+        }
+        uids.append(uid);
+    }
+    return uids;
+}
+}
+
+// Kart okutma yolundaki ölçümler. ctest'e eklenmez, elle çalıştırılır: ./bench_attendance
+class BenchAttendance : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void uidLookupHexString();
+    void uidLookupCardUid();
+    void journalAppend();
+
+private:
+    QVector<QByteArray> m_rawUids;
+};
+
+void BenchAttendance::initTestCase()
+{
+    m_rawUids = makeRawUids(kRosterSize);
+}
+
+// Eski yol: her okutmada "04 A1 B2 C3 ..." metni üretilir, metin anahtarlı tabloda aranır
+void BenchAttendance::uidLookupHexString()
+{
+    QHash<QString, int> slotForUid;
+    for (int i = 0; i < m_rawUids.count(); ++i) {
+        slotForUid.insert(QString(m_rawUids.at(i).toHex(' ').toUpper()), i);
+    }
+
+    int found = 0;
+    QBENCHMARK {
+        for (int tap = 0; tap < kTapsPerIteration; ++tap) {
+            const QByteArray& raw = m_rawUids.at(tap % m_rawUids.count());
+            QString key(raw.toHex(' ').toUpper());
+            found += slotForUid.value(key, -1) >= 0;
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+// Şimdiki yol: ham baytlar CardUid'e kopyalanır, oturum listesinde bellek ayırmadan aranır
+void BenchAttendance::uidLookupCardUid()
+{
+    QVector<SessionRosterEntry> entries;
+    for (int i = 0; i < m_rawUids.count(); ++i) {
+        SessionRosterEntry entry;
+        entry.student.id = i + 1;
+        entry.student.cardUID = CardUid::fromByteArray(m_rawUids.at(i));
+        entries.append(entry);
+    }
+    SessionRoster roster;
+    roster.build(1, 1, entries);
+
+    int found = 0;
+    QBENCHMARK {
+        for (int tap = 0; tap < kTapsPerIteration; ++tap) {
+            const QByteArray& raw = m_rawUids.at(tap % m_rawUids.count());
+            CardUid uid = CardUid::fromBytes(raw.constData(), raw.size());
+            found += roster.find(uid) >= 0;
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+// Günlüğe ekleme hızı: her turda 10k okutma eklenir, sonra commit sonrası gibi sıkıştırılır.
+// Günlük yolu okutma yolunun darboğazı olmamalı; saniyede 10k okutmanın altı hata sayılır.
+void BenchAttendance::journalAppend()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    TapJournal journal(dir.filePath("bench.journal"));
+    QVERIFY(journal.open());
+
+    QVector<CardUid> uids;
+    for (const QByteArray& raw : m_rawUids) {
+        uids.append(CardUid::fromByteArray(raw));
+    }
+
+    qint64 wallMs = QDateTime::currentMSecsSinceEpoch();
+    bool appended = true;
+    QBENCHMARK {
+        for (int tap = 0; tap < kJournalTaps; ++tap) {
+            appended &= journal.append(1, tap % uids.count() + 1, uids.at(tap % uids.count()), wallMs + tap);
+        }
+        journal.compact();
+    }
+    QVERIFY(appended);
+
+    const TapJournalStats& stats = journal.stats();
+    qInfo().noquote() << QString("Günlük: %1 ekleme, saniyede %2, en uzun %3 ns, yeniden eşleme %4")
+                         .arg(stats.appends).arg(qRound64(stats.appendsPerSecond()))
+                         .arg(stats.maxAppendNs).arg(stats.remaps);
+    QVERIFY(stats.appendsPerSecond() > kRequiredJournalTapsPerSecond);
+    journal.close();
+}
+
+QTEST_GUILESS_MAIN(BenchAttendance)
+#include "bench_attendance.moc"
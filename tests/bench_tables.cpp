@@ -0,0 +1,202 @@
+#include <QtTest>
+#include <QTableView>
+#include <QTableWidget>
+#include "recordtablemodel.h"
+#include "tablehelper.h"
+#include "databasemanager.h"
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace {
+const int kOverviewRows = 100000;
+const int kResizeRows = 50000;
+
+// Yığında kullanılan bayt; glibc yoksa -1
+qint64 heapInUse()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return qint64(info.uordblks) + qint64(info.hblkhd);
+#else
+    return -1;
+#endif
+}
+
+QString megabytes(qint64 bytes)
+{
+    return bytes < 0 ? QString("?") : QString::number(bytes / (1024.0 * 1024.0), 'f', 1) + " MB";
+}
+
+// Admin genel bakışının veritabanından döndüğü biçimde örnek satırlar
+QVector<AdminAttendanceOverview> makeOverview(int count)
+{
+    QVector<AdminAttendanceOverview> rows;
+    rows.reserve(count);
+    QDateTime start(QDate(2025, 9, 1), QTime(9, 0));
+    for (int i = 0; i < count; ++i) {
+        QDateTime at = start.addSecs(qint64(i) * 3600);
+        rows.append({i + 1,
+                     QString("Hafta %1 - Bölüm %2 yoklaması").arg(i / 40 + 1).arg(i % 7 + 1),
+                     QString("Öğretmen %1").arg(i % 25 + 1),
+                     QString("Ders %1").arg(i % 60 + 1),
+                     at.toString("dd.MM.yyyy"),
+                     at.toString("HH:mm"),
+                     i % 50 == 0 ? "active" : "completed",
+                     20 + i % 40});
+    }
+    return rows;
+}
+
+// AdminWidget::setupTableHeaders ile aynı sütunlar
+RecordTableModel<AdminAttendanceOverview>* makeOverviewModel(QObject* parent)
+{
+    return new RecordTableModel<AdminAttendanceOverview>({
+        {"Yoklama Başlığı", [](const AdminAttendanceOverview& session) { return session.sessionTitle; }},
+        {"Öğretmen", [](const AdminAttendanceOverview& session) { return session.teacherName; }},
+        {"Tarih", [](const AdminAttendanceOverview& session) { return session.date; }},
+        {"Başlangıç", [](const AdminAttendanceOverview& session) { return session.startTime; }},
+        {"Durum", [](const AdminAttendanceOverview& session) {
+            return QString(session.status == "active" ? "Aktif" : "Tamamlandı");
+        }}
+    }, parent);
+}
+
+// Örneklemeden önceki TableHelper::resizeColumnsToContent: tüm satırlar ölçülür
+void legacyResizeColumnsToContent(QTableView* table)
+{
+    QAbstractItemModel* model = table->model();
+    table->resizeColumnsToContents();
+
+    QFontMetrics fm(table->font());
+    for (int i = 0; i < model->columnCount(); ++i) {
+        int currentWidth = table->columnWidth(i);
+        int minWidth = 80;
+
+        QString headerText = model->headerData(i, Qt::Horizontal).toString();
+        if (!headerText.isEmpty()) {
+            minWidth = qMax(minWidth, fm.horizontalAdvance(headerText) + 20);
+        }
+
+        int maxContentWidth = minWidth;
+        for (int row = 0; row < model->rowCount(); ++row) {
+            QString text = model->index(row, i).data().toString();
+            if (!text.isEmpty()) {
+                maxContentWidth = qMax(maxContentWidth, fm.horizontalAdvance(text) + 20);
+            }
+        }
+
+        table->setColumnWidth(i, qMin(qMax(currentWidth, maxContentWidth), 300));
+    }
+}
+
+QString columnWidths(QTableView* table)
+{
+    QStringList widths;
+    for (int i = 0; i < table->model()->columnCount(); ++i) {
+        widths.append(QString::number(table->columnWidth(i)));
+    }
+    return widths.join(' ');
+}
+}
+
+// Tablo doldurma ölçümleri. ctest'e eklenmez, elle çalıştırılır:
+//   QT_QPA_PLATFORM=offscreen ./bench_tables
+class BenchTables : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void fillOverviewModel();
+    void fillOverviewTableWidget();
+    void resizeColumnsLegacy();
+    void resizeColumnsSampled();
+};
+
+// Şimdiki yol: kayıt vektörü modele verilir, hücre metni çizilirken üretilir
+void BenchTables::fillOverviewModel()
+{
+    const QVector<AdminAttendanceOverview> sessions = makeOverview(kOverviewRows);
+    QTableView view;
+    auto* model = makeOverviewModel(&view);
+    view.setModel(model);
+
+    qint64 heapBefore = heapInUse();
+    QElapsedTimer timer;
+    timer.start();
+    model->setRecords(sessions);
+    qint64 elapsedMs = timer.elapsed();
+    // Model sonuç vektörünü paylaşır (implicit sharing); kopya ancak kayıt değişirse oluşur
+    qint64 heapAfter = heapInUse();
+
+    QCOMPARE(model->rowCount(), kOverviewRows);
+    qInfo().noquote() << QString("RecordTableModel: %1 satır, %2 ms, bellek +%3")
+                         .arg(kOverviewRows).arg(elapsedMs).arg(megabytes(heapAfter - heapBefore));
+}
+
+// Eski yol (QTableWidget): hücre başına bir QTableWidgetItem
+void BenchTables::fillOverviewTableWidget()
+{
+    const QVector<AdminAttendanceOverview> sessions = makeOverview(kOverviewRows);
+    QTableWidget table;
+    table.setColumnCount(5);
+    table.setHorizontalHeaderLabels({"Yoklama Başlığı", "Öğretmen", "Tarih", "Başlangıç", "Durum"});
+
+    qint64 heapBefore = heapInUse();
+    QElapsedTimer timer;
+    timer.start();
+    table.setRowCount(sessions.count());
+    for (int i = 0; i < sessions.count(); ++i) {
+        const auto& session = sessions[i];
+
+        QTableWidgetItem* titleItem = new QTableWidgetItem(session.sessionTitle);
+        titleItem->setData(Qt::UserRole, session.sessionId);
+        table.setItem(i, 0, titleItem);
+        table.setItem(i, 1, new QTableWidgetItem(session.teacherName));
+        table.setItem(i, 2, new QTableWidgetItem(session.date));
+        table.setItem(i, 3, new QTableWidgetItem(session.startTime));
+        table.setItem(i, 4, new QTableWidgetItem(session.status == "active" ? "Aktif" : "Tamamlandı"));
+    }
+    qint64 elapsedMs = timer.elapsed();
+    qint64 heapAfter = heapInUse();
+
+    QCOMPARE(table.rowCount(), kOverviewRows);
+    qInfo().noquote() << QString("QTableWidget: %1 satır, %2 ms, bellek +%3")
+                         .arg(kOverviewRows).arg(elapsedMs).arg(megabytes(heapAfter - heapBefore));
+}
+
+// Eski sütun genişliği hesabı, 50k satır
+void BenchTables::resizeColumnsLegacy()
+{
+    QTableView view;
+    auto* model = makeOverviewModel(&view);
+    view.setModel(model);
+    model->setRecords(makeOverview(kResizeRows));
+
+    QElapsedTimer timer;
+    timer.start();
+    legacyResizeColumnsToContent(&view);
+    qInfo().noquote() << QString("Eski genişlik hesabı: %1 satır, %2 ms, genişlikler: %3")
+                         .arg(kResizeRows).arg(timer.elapsed()).arg(columnWidths(&view));
+}
+
+// Örneklenen satırlar ve metin genişliği önbelleği; ikinci çağrı önbellek doluyken
+void BenchTables::resizeColumnsSampled()
+{
+    QTableView view;
+    auto* model = makeOverviewModel(&view);
+    view.setModel(model);
+    model->setRecords(makeOverview(kResizeRows));
+
+    QElapsedTimer timer;
+    timer.start();
+    TableHelper::resizeColumnsToContent(&view);
+    qint64 coldMs = timer.restart();
+    TableHelper::resizeColumnsToContent(&view);
+    qint64 warmMs = timer.elapsed();
+    qInfo().noquote() << QString("Örneklenen genişlik hesabı: %1 satır, ilk %2 ms, tekrar %3 ms, genişlikler: %4")
+                         .arg(kResizeRows).arg(coldMs).arg(warmMs).arg(columnWidths(&view));
+}
+
+QTEST_MAIN(BenchTables)
+#include "bench_tables.moc"
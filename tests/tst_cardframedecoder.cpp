@@ -0,0 +1,237 @@
+#include <QtTest>
+#include <QRandomGenerator>
+#include "cardframedecoder.h"
+
+namespace {
+
+// STX | LEN | PCB | INS | DATA... | LRC | ETX
+QByteArray makeFrame(quint8 ins, const QByteArray& data)
+{
+    QByteArray frame;
+    frame.append(char(STX));
+    frame.append(char(CardFrameDecoder::kMinFrameLength + data.size()));
+    frame.append(char(PCB));
+    frame.append(char(ins));
+    frame.append(data);
+    frame.append(char(CardFrameDecoder::calculateLRC(frame.constData(), frame.size())));
+    frame.append(char(ETX));
+    return frame;
+}
+
+QByteArray uidFrame(const QByteArray& uid)
+{
+    return makeFrame(INS_DO, uid);
+}
+
+// Çözücüye parçalar halinde verir, çıkan tüm çerçeveleri toplar
+QList<QByteArray> decodeChunks(CardFrameDecoder& decoder, const QList<QByteArray>& chunks)
+{
+    QList<QByteArray> frames;
+    QByteArray frame;
+    for (const QByteArray& chunk : chunks) {
+        int offset = 0;
+        while (offset < chunk.size()) {
+            offset += decoder.feed(chunk.constData() + offset, chunk.size() - offset);
+            while (decoder.nextFrame(frame)) {
+                frames.append(QByteArray(frame.constData(), frame.size())); // Dahili tampondan kopya
+            }
+        }
+    }
+    return frames;
+}
+
+bool isWellFormed(const QByteArray& frame)
+{
+    if (frame.size() < CardFrameDecoder::kMinFrameLength) return false;
+    return quint8(frame.at(0)) == STX
+        && quint8(frame.at(1)) == frame.size()
+        && quint8(frame.at(frame.size() - 1)) == ETX
+        && CardFrameDecoder::calculateLRC(frame.constData(), frame.size() - 2) == quint8(frame.at(frame.size() - 2));
+}
+
+} // namespace
+
+class TestCardFrameDecoder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void corpus_data();
+    void corpus();
+    void byteByByte();
+    void fuzzRandomBytes_data();
+    void fuzzRandomBytes();
+    void fuzzFramesInNoise_data();
+    void fuzzFramesInNoise();
+    void benchmarkDecode();
+};
+
+// Okuyucudan gelebilecek bilinen akış biçimleri (fuzz korpusu)
+void TestCardFrameDecoder::corpus_data()
+{
+    QTest::addColumn<QList<QByteArray>>("chunks");
+    QTest::addColumn<QList<QByteArray>>("expected");
+
+    const QByteArray uid4 = QByteArray::fromHex("04A1B2C3");
+    const QByteArray uid7 = QByteArray::fromHex("04A1B2C3D4E5F6");
+    const QByteArray frame4 = uidFrame(uid4);
+    const QByteArray frame7 = uidFrame(uid7);
+    const QByteArray empty = makeFrame(INS_DO, QByteArray());
+    const QByteArray etxInPayload = uidFrame(QByteArray::fromHex("0403B203"));
+
+    QByteArray badLrc = frame4;
+    badLrc[badLrc.size() - 2] = char(badLrc.at(badLrc.size() - 2) ^ 0x5A);
+    QByteArray badEtx = frame4;
+    badEtx[badEtx.size() - 1] = char(0x7F);
+    QByteArray badLen = frame4;
+    badLen[1] = char(3);
+
+    QTest::newRow("tek çerçeve") << QList<QByteArray>{frame4} << QList<QByteArray>{frame4};
+    QTest::newRow("boş yanıt") << QList<QByteArray>{empty} << QList<QByteArray>{empty};
+    QTest::newRow("iki parçaya bölünmüş")
+        << QList<QByteArray>{frame7.left(3), frame7.mid(3)} << QList<QByteArray>{frame7};
+    QTest::newRow("LEN öncesi bölünmüş")
+        << QList<QByteArray>{frame4.left(1), frame4.mid(1)} << QList<QByteArray>{frame4};
+    QTest::newRow("art arda iki çerçeve")
+        << QList<QByteArray>{frame4 + frame7} << QList<QByteArray>{frame4, frame7};
+    QTest::newRow("başta çöp")
+        << QList<QByteArray>{QByteArray::fromHex("FF00AA55") + frame4} << QList<QByteArray>{frame4};
+    QTest::newRow("veride ETX") << QList<QByteArray>{etxInPayload} << QList<QByteArray>{etxInPayload};
+    QTest::newRow("hatalı LRC sonrası geçerli")
+        << QList<QByteArray>{badLrc + frame7} << QList<QByteArray>{frame7};
+    QTest::newRow("hatalı ETX sonrası geçerli")
+        << QList<QByteArray>{badEtx + frame7} << QList<QByteArray>{frame7};
+    QTest::newRow("geçersiz LEN sonrası geçerli")
+        << QList<QByteArray>{badLen + frame7} << QList<QByteArray>{frame7};
+    QTest::newRow("yarım çerçeve") << QList<QByteArray>{frame4.left(frame4.size() - 1)} << QList<QByteArray>{};
+}
+
+void TestCardFrameDecoder::corpus()
+{
+    QFETCH(QList<QByteArray>, chunks);
+    QFETCH(QList<QByteArray>, expected);
+
+    CardFrameDecoder decoder;
+    QCOMPARE(decodeChunks(decoder, chunks), expected);
+}
+
+void TestCardFrameDecoder::byteByByte()
+{
+    // Seri port baytları tek tek de teslim edebilir
+    const QByteArray stream = uidFrame(QByteArray::fromHex("04A1B2C3")) + uidFrame(QByteArray::fromHex("04112233445566778899"));
+    QList<QByteArray> chunks;
+    for (char byte : stream) {
+        chunks.append(QByteArray(1, byte));
+    }
+
+    CardFrameDecoder decoder;
+    QList<QByteArray> frames = decodeChunks(decoder, chunks);
+    QCOMPARE(frames.count(), 2);
+    QCOMPARE(frames.at(0) + frames.at(1), stream);
+    QCOMPARE(decoder.bufferedBytes(), 0);
+}
+
+void TestCardFrameDecoder::fuzzRandomBytes_data()
+{
+    QTest::addColumn<quint32>("seed");
+    for (quint32 seed = 1; seed <= 16; ++seed) {
+        QTest::newRow(qPrintable(QString("tohum %1").arg(seed))) << seed;
+    }
+}
+
+void TestCardFrameDecoder::fuzzRandomBytes()
+{
+    // Tamamen rastgele akış: çözücü takılmamalı, tampon taşmamalı, çıkan her çerçeve geçerli olmalı
+    QFETCH(quint32, seed);
+    QRandomGenerator random(seed);
+
+    CardFrameDecoder decoder;
+    QByteArray frame;
+    for (int round = 0; round < 2000; ++round) {
+        QByteArray chunk(random.bounded(1, 64), Qt::Uninitialized);
+        for (char& byte : chunk) {
+            // STX sık gelsin ki çerçeve arama yolları da denensin
+            byte = random.bounded(4) == 0 ? char(STX) : char(random.bounded(256));
+        }
+
+        int offset = 0;
+        int stalls = 0;
+        while (offset < chunk.size()) {
+            int accepted = decoder.feed(chunk.constData() + offset, chunk.size() - offset);
+            offset += accepted;
+            while (decoder.nextFrame(frame)) {
+                QVERIFY2(isWellFormed(frame), frame.toHex(' ').constData());
+            }
+            QVERIFY(decoder.bufferedBytes() <= CardFrameDecoder::kCapacity);
+            // Tampon dolu ve çerçeve çıkmıyorsa çözücü kilitlenmiş demektir
+            stalls = accepted == 0 ? stalls + 1 : 0;
+            QVERIFY(stalls < 2);
+        }
+    }
+}
+
+void TestCardFrameDecoder::fuzzFramesInNoise_data()
+{
+    fuzzRandomBytes_data();
+}
+
+void TestCardFrameDecoder::fuzzFramesInNoise()
+{
+    // STX içermeyen gürültü arasına gömülü, rastgele bölünmüş çerçevelerin hepsi sırayla çıkmalı
+    QFETCH(quint32, seed);
+    QRandomGenerator random(seed);
+
+    QByteArray stream;
+    QList<QByteArray> expected;
+    for (int i = 0; i < 300; ++i) {
+        QByteArray noise(random.bounded(0, 12), Qt::Uninitialized);
+        for (char& byte : noise) {
+            do {
+                byte = char(random.bounded(256));
+            } while (quint8(byte) == STX);
+        }
+        QByteArray uid(random.bounded(4) == 0 ? 0 : 4 + 3 * random.bounded(3), Qt::Uninitialized);
+        for (char& byte : uid) {
+            byte = char(random.bounded(256));
+        }
+        QByteArray frame = uidFrame(uid);
+        stream += noise + frame;
+        expected.append(frame);
+    }
+
+    QList<QByteArray> chunks;
+    for (int offset = 0; offset < stream.size();) {
+        int size = random.bounded(1, 40);
+        chunks.append(stream.mid(offset, size));
+        offset += size;
+    }
+
+    CardFrameDecoder decoder;
+    QCOMPARE(decodeChunks(decoder, chunks), expected);
+    QCOMPARE(decoder.stats().lrcErrors, 0);
+}
+
+void TestCardFrameDecoder::benchmarkDecode()
+{
+    // Tipik okuyucu trafiği: UID yanıtları ve boş yanıtlar, 16 baytlık okumalar halinde
+    QByteArray stream;
+    for (int i = 0; i < 512; ++i) {
+        stream += i % 4 == 0 ? uidFrame(QByteArray::fromHex("04A1B2C3D4E5F6")) : makeFrame(INS_DO, QByteArray());
+    }
+
+    CardFrameDecoder decoder;
+    QByteArray frame;
+    int frames = 0;
+    QBENCHMARK {
+        for (int offset = 0; offset < stream.size(); offset += 16) {
+            decoder.feed(stream.constData() + offset, qMin(16, int(stream.size()) - offset));
+            while (decoder.nextFrame(frame)) {
+                ++frames;
+            }
+        }
+    }
+    QVERIFY(frames > 0);
+}
+
+QTEST_APPLESS_MAIN(TestCardFrameDecoder)
+#include "tst_cardframedecoder.moc"
@@ -0,0 +1,142 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QtEndian>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include "databasemanager.h"
+#include "schemamigrator.h"
+
+namespace {
+const char* const kSeedConnectionName = "tst_queryplans_seed";
+
+const int kStudents = 2000;
+const int kSessionsPerCourse = 60;
+const int kAttendeesPerSession = 40;
+
+bool exec(QSqlQuery& query)
+{
+    if (query.exec()) return true;
+    qWarning() << "Örnek veri eklenemedi:" << query.lastError().text();
+    return false;
+}
+
+// Planlayıcı gerçekçi istatistiklerle karar versin diye okul ölçeğinde örnek veri
+bool seed(QSqlDatabase& db)
+{
+    db.transaction();
+    QSqlQuery query(db);
+
+    query.prepare("INSERT INTO students (cardUID, studentNumber, firstName, lastName, createdAt, createdBy) "
+                  "VALUES (?, ?, 'Ad', 'Soyad', '2026-01-01T08:00:00', 1)");
+    for (int i = 1; i <= kStudents; ++i) {
+        QByteArray uid(4, '\0');
+        qToBigEndian<quint32>(quint32(0x04000000 + i), uid.data());
+        query.addBindValue(uid);
+        query.addBindValue(QString::number(20260000 + i));
+        if (!exec(query)) return false;
+    }
+
+    QVector<int> courseIds;
+    QVector<int> teacherIds;
+    query.exec("SELECT id, teacher_id FROM courses ORDER BY id");
+    while (query.next()) {
+        courseIds.append(query.value(0).toInt());
+        teacherIds.append(query.value(1).toInt());
+    }
+
+    // Her öğrenci iki derse kayıtlı
+    query.prepare("INSERT INTO enrollments (courseId, studentId, enrolledAt, enrolledBy) "
+                  "VALUES (?, ?, '2026-01-01T08:00:00', 1)");
+    for (int student = 1; student <= kStudents; ++student) {
+        for (int k = 0; k < 2; ++k) {
+            query.addBindValue(courseIds.at((student + k) % courseIds.count()));
+            query.addBindValue(student);
+            if (!exec(query)) return false;
+        }
+    }
+
+    QSqlQuery records(db);
+    records.prepare("INSERT INTO attendanceRecords (sessionId, studentId, time, status) "
+                    "VALUES (?, ?, '2026-01-01T09:00:00', 'present')");
+    query.prepare("INSERT INTO attendance_sessions (teacher_id, course_id, title, start_time, end_time, is_active) "
+                  "VALUES (?, ?, 'Yoklama', ?, ?, 0)");
+    for (int c = 0; c < courseIds.count(); ++c) {
+        for (int s = 0; s < kSessionsPerCourse; ++s) {
+            QDateTime start = QDateTime(QDate(2026, 1, 1), QTime(9, 0), Qt::UTC).addDays(s).addSecs(c * 3600);
+            query.addBindValue(teacherIds.at(c));
+            query.addBindValue(courseIds.at(c));
+            query.addBindValue(start.toString("yyyy-MM-dd HH:mm:ss"));
+            query.addBindValue(start.addSecs(3000).toString("yyyy-MM-dd HH:mm:ss"));
+            if (!exec(query)) return false;
+
+            int sessionId = query.lastInsertId().toInt();
+            for (int a = 0; a < kAttendeesPerSession; ++a) {
+                records.addBindValue(sessionId);
+                records.addBindValue((sessionId * 37 + a * 41) % kStudents + 1);
+                // Aynı öğrenci ikinci kez seçilirse UNIQUE ihlali olur, o satır atlanır
+                records.exec();
+            }
+        }
+    }
+
+    query.prepare("INSERT INTO attendanceDeleteRequests (sessionId, requestedBy, requestedAt, reason, status) "
+                  "VALUES (?, ?, '2026-02-01T10:00:00', 'Test', ?)");
+    for (int sessionId = 1; sessionId <= 50; ++sessionId) {
+        query.addBindValue(sessionId);
+        query.addBindValue(teacherIds.first());
+        query.addBindValue(sessionId % 5 == 0 ? "pending" : "approved");
+        if (!exec(query)) return false;
+    }
+
+    if (!db.commit()) return false;
+    return query.exec("ANALYZE");
+}
+}
+
+// Sık çalışan sorguların hiçbiri büyük tablolarda indekssiz tam tarama (SCAN) yapmamalı.
+// Uygulama açılışında değil burada kontrol edilir; tarama bulunursa ayrıntısı uyarı olarak yazılır.
+class TestQueryPlans : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void noFullScans();
+
+private:
+    QTemporaryDir m_dir;
+};
+
+void TestQueryPlans::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    QString path = m_dir.filePath("yoklama_test.db");
+
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", kSeedConnectionName);
+        db.setDatabaseName(path);
+        QVERIFY(db.open());
+        QVERIFY(SchemaMigrator::migrate(db));
+        QCOMPARE(SchemaMigrator::currentVersion(db), SchemaMigrator::latestVersion());
+        QVERIFY(seed(db));
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(kSeedConnectionName);
+
+    QVERIFY(DatabaseManager::instance().openDatabase(path));
+}
+
+void TestQueryPlans::cleanupTestCase()
+{
+    DatabaseManager::instance().closeDatabase();
+}
+
+void TestQueryPlans::noFullScans()
+{
+    QVERIFY(DatabaseManager::instance().verifyQueryPlans());
+}
+
+QTEST_GUILESS_MAIN(TestQueryPlans)
+#include "tst_queryplans.moc"
@@ -0,0 +1,87 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include "schemamigrator.h"
+#include "carduid.h"
+
+namespace {
+const char* const kConnectionName = "tst_schemamigrator";
+}
+
+class TestSchemaMigrator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    void binaryCardUidCollisions();
+
+private:
+    QTemporaryDir* m_dir = nullptr;
+};
+
+void TestSchemaMigrator::init()
+{
+    m_dir = new QTemporaryDir;
+    QVERIFY(m_dir->isValid());
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", kConnectionName);
+    db.setDatabaseName(m_dir->filePath("yoklama_test.db"));
+    QVERIFY(db.open());
+}
+
+void TestSchemaMigrator::cleanup()
+{
+    QSqlDatabase::database(kConnectionName, false).close();
+    QSqlDatabase::removeDatabase(kConnectionName);
+    delete m_dir;
+    m_dir = nullptr;
+}
+
+// Sürüm 3'teki TEXT UNIQUE sütunu aynı kartı farklı yazımlarla kabul ediyordu; sürüm 4
+// ikili anahtara geçerken çakışanlar göçü durdurmamalı ve hiçbir öğrenci kaybolmamalı
+void TestSchemaMigrator::binaryCardUidCollisions()
+{
+    QSqlDatabase db = QSqlDatabase::database(kConnectionName);
+    QSqlQuery query(db);
+    QVERIFY(query.exec("CREATE TABLE students ("
+                       "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+                       "cardUID TEXT UNIQUE NOT NULL, "
+                       "studentNumber TEXT UNIQUE NOT NULL, "
+                       "firstName TEXT NOT NULL, "
+                       "lastName TEXT NOT NULL, "
+                       "createdAt TEXT NOT NULL, "
+                       "createdBy INTEGER NOT NULL, "
+                       "password TEXT)"));
+    const QStringList uids = {"04 A1 B2 C3", "04a1b2c3", "04:A1:B2:C3", "ELLE-GIRILDI", "04 D4 E5 F6"};
+    for (int i = 0; i < uids.count(); ++i) {
+        query.prepare("INSERT INTO students (cardUID, studentNumber, firstName, lastName, createdAt, createdBy) "
+                      "VALUES (?, ?, 'Ad', 'Soyad', '2025-01-01T08:00:00', 1)");
+        query.addBindValue(uids.at(i));
+        query.addBindValue(QString::number(1000 + i));
+        QVERIFY2(query.exec(), qPrintable(query.lastError().text()));
+    }
+    QVERIFY(query.exec("PRAGMA user_version = 3"));
+
+    QVERIFY(SchemaMigrator::migrate(db));
+    QCOMPARE(SchemaMigrator::currentVersion(db), SchemaMigrator::latestVersion());
+
+    QVERIFY(query.exec("SELECT studentNumber, cardUID FROM students ORDER BY id"));
+    QHash<QString, QByteArray> keys;
+    while (query.next()) {
+        keys.insert(query.value(0).toString(), query.value(1).toByteArray());
+    }
+    QCOMPARE(keys.count(), uids.count());
+
+    // İlk yazım ikili anahtarı alır, çakışanlar özgün metinleriyle kalır
+    QCOMPARE(keys.value("1000"), CardUid::fromString("04 A1 B2 C3").toByteArray());
+    QCOMPARE(keys.value("1001"), QByteArray("04a1b2c3"));
+    QCOMPARE(keys.value("1002"), QByteArray("04:A1:B2:C3"));
+    QCOMPARE(keys.value("1003"), QByteArray("ELLE-GIRILDI"));
+    QCOMPARE(keys.value("1004"), CardUid::fromString("04 D4 E5 F6").toByteArray());
+}
+
+QTEST_GUILESS_MAIN(TestSchemaMigrator)
+#include "tst_schemamigrator.moc"
@@ -0,0 +1,152 @@
+#include <QtTest>
+#include <QThread>
+#include <QElapsedTimer>
+#include <atomic>
+#include "spscqueue.h"
+
+namespace {
+// Okuyucu thread'inin kuyruğuna koyduğuna benzer olay: sıra numarası ve okuma zamanı
+struct Event {
+    quint32 seq = 0;
+    qint64 atMs = 0;
+};
+
+// CardReaderWorker::kQueueCapacity ile aynı
+constexpr int kCapacity = 256;
+}
+
+class TestSpscQueue : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void fifoAndFull();
+    void wrapsAroundRing();
+    void concurrentOrder();
+    void blockedConsumer();
+};
+
+void TestSpscQueue::fifoAndFull()
+{
+    SpscQueue<int, 8> queue;
+    int value = -1;
+    QVERIFY(!queue.pop(value));
+
+    for (int i = 0; i < 8; ++i) {
+        QVERIFY(queue.push(i));
+    }
+    QCOMPARE(queue.size(), 8);
+    QVERIFY(!queue.push(8)); // Dolu kuyruk eleman kabul etmez
+
+    for (int i = 0; i < 8; ++i) {
+        QVERIFY(queue.pop(value));
+        QCOMPARE(value, i);
+    }
+    QVERIFY(!queue.pop(value));
+    QCOMPARE(queue.size(), 0);
+}
+
+void TestSpscQueue::wrapsAroundRing()
+{
+    // Baş ve kuyruk halkayı defalarca dolaşır
+    SpscQueue<int, 4> queue;
+    int next = 0;
+    int expected = 0;
+    int value = -1;
+    for (int round = 0; round < 10000; ++round) {
+        int pushes = round % 4 + 1;
+        for (int i = 0; i < pushes; ++i) {
+            QVERIFY(queue.push(next++));
+        }
+        for (int i = 0; i < pushes; ++i) {
+            QVERIFY(queue.pop(value));
+            QCOMPARE(value, expected++);
+        }
+    }
+}
+
+void TestSpscQueue::concurrentOrder()
+{
+    // Üretici doluysa bekleyip tekrar dener; tüketici her elemanı bir kez ve sırayla görmeli
+    const quint32 count = 1000000;
+    SpscQueue<Event, kCapacity> queue;
+
+    QThread* producer = QThread::create([&queue, count]() {
+        for (quint32 seq = 1; seq <= count; ++seq) {
+            while (!queue.push({seq, 0})) {
+                QThread::yieldCurrentThread();
+            }
+        }
+    });
+    producer->start();
+
+    quint32 expected = 1;
+    Event event;
+    QElapsedTimer timer;
+    timer.start();
+    while (expected <= count && timer.elapsed() < 30000) {
+        if (queue.pop(event)) {
+            QCOMPARE(event.seq, expected);
+            ++expected;
+        } else {
+            QThread::yieldCurrentThread();
+        }
+    }
+    QVERIFY(producer->wait(5000));
+    delete producer;
+    QCOMPARE(expected, count + 1);
+}
+
+void TestSpscQueue::blockedConsumer()
+{
+    // Arayüz thread'i modal pencere ya da tablo yüklemesiyle bloke iken okuyucu okumaya devam eder:
+    // tüketici 300 ms hiç boşaltmazken üretici 2 ms'de bir okuma koyar. Kapasite içindeki
+    // okumaların hiçbiri kaybolmamalı, üretici de beklememeli.
+    SpscQueue<Event, kCapacity> queue;
+    const quint32 reads = 150;
+    std::atomic<int> dropped{0};
+    std::atomic<qint64> maxPushNs{0};
+
+    QThread* producer = QThread::create([&]() {
+        QElapsedTimer clock;
+        clock.start();
+        for (quint32 seq = 1; seq <= reads; ++seq) {
+            QElapsedTimer pushTimer;
+            pushTimer.start();
+            if (!queue.push({seq, clock.elapsed()})) {
+                dropped.fetch_add(1);
+            }
+            qint64 pushNs = pushTimer.nsecsElapsed();
+            if (pushNs > maxPushNs.load()) {
+                maxPushNs.store(pushNs);
+            }
+            QThread::msleep(2);
+        }
+    });
+    producer->start();
+
+    QThread::msleep(300); // Bloke arayüz
+    QVERIFY(queue.size() > 0);
+
+    quint32 expected = 1;
+    Event event;
+    QElapsedTimer timer;
+    timer.start();
+    while (expected <= reads && timer.elapsed() < 10000) {
+        if (queue.pop(event)) {
+            QCOMPARE(event.seq, expected);
+            ++expected;
+        } else {
+            QThread::msleep(1);
+        }
+    }
+    QVERIFY(producer->wait(5000));
+    delete producer;
+
+    QCOMPARE(dropped.load(), 0);
+    QCOMPARE(expected, reads + 1);
+    qDebug() << "En uzun push:" << maxPushNs.load() << "ns";
+}
+
+QTEST_GUILESS_MAIN(TestSpscQueue)
+#include "tst_spscqueue.moc"